@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/image_inference.h"
+
+#include <gst/video/video.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Benchmarks {
+
+// Inference output filled by benchmark instead of inference device
+class FloatOutputBlob : public InferenceBackend::OutputBlob {
+  public:
+    FloatOutputBlob(std::vector<size_t> dims, std::vector<float> data) : dims(std::move(dims)), data(std::move(data)) {
+    }
+
+    const std::vector<size_t> &GetDims() const override {
+        return dims;
+    }
+
+    Layout GetLayout() const override {
+        return dims.size() == 4 ? Layout::NCHW : Layout::ANY;
+    }
+
+    Precision GetPrecision() const override {
+        return Precision::FP32;
+    }
+
+    const void *GetData() const override {
+        return data.data();
+    }
+
+  private:
+    std::vector<size_t> dims;
+    std::vector<float> data;
+};
+
+inline GstVideoInfo MakeVideoInfo(guint width, guint height, GstVideoFormat format = GST_VIDEO_FORMAT_BGRx) {
+    GstVideoInfo info;
+    gst_video_info_init(&info);
+    gst_video_info_set_format(&info, format, width, height);
+    return info;
+}
+
+// Fixed seed, so every run of the benchmark processes the same data
+inline std::mt19937 &RandomEngine() {
+    static std::mt19937 engine(2020);
+    return engine;
+}
+
+inline float RandomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(RandomEngine());
+}
+
+} // namespace Benchmarks
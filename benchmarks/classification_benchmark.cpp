@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include "classification_post_processors.h"
+#include "copy_blob_to_gststruct.h"
+#include "tensor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+using namespace Benchmarks;
+
+namespace {
+
+GValueArray *MakeLabels(size_t labels_number) {
+    GValueArray *labels = g_value_array_new(labels_number);
+    GValue label = G_VALUE_INIT;
+    g_value_init(&label, G_TYPE_STRING);
+    for (size_t i = 0; i < labels_number; i++) {
+        g_value_set_string(&label, ("label_" + std::to_string(i)).c_str());
+        g_value_array_append(labels, &label);
+    }
+    g_value_unset(&label);
+    return labels;
+}
+
+// Result tensor of one ROI as classification post-processor makes it: copy of layer description from model-proc,
+// output blob copied into it, then converter applied
+void TensorToLabel(benchmark::State &state, const std::string &method) {
+    const size_t outputs_number = state.range(0);
+    std::vector<float> data(outputs_number);
+    size_t labels_number = outputs_number;
+    if (method == "compound") {
+        labels_number = outputs_number * 2;
+        for (float &value : data)
+            value = RandomFloat(0.f, 1.f);
+    } else if (method == "index") {
+        // sequence of label indexes terminated by -1, e.g. license plate symbols
+        labels_number = 71;
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = i < outputs_number / 2 ? static_cast<float>(i % labels_number) : -1.f;
+    } else {
+        for (float &value : data)
+            value = RandomFloat(0.f, 1.f);
+    }
+    InferenceBackend::OutputBlob::Ptr blob =
+        std::make_shared<FloatOutputBlob>(std::vector<size_t>{1, outputs_number}, std::move(data));
+    GValueArray *labels = MakeLabels(labels_number);
+    GstStructure *model_proc_info = gst_structure_new("layer", "converter", G_TYPE_STRING, "tensor_to_label", "method",
+                                                      G_TYPE_STRING, method.c_str(), NULL);
+    ClassificationPlugin::ConverterFunctionType converter = ClassificationPlugin::getConverter(model_proc_info);
+
+    for (auto _ : state) {
+        GstStructure *result = gst_structure_copy(model_proc_info);
+        CopyOutputBlobToGstStructure(blob, result, "model", "prob", 1, 0);
+        GVA::Tensor tensor(result);
+        converter(tensor, labels);
+        gst_structure_free(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    gst_structure_free(model_proc_info);
+    g_value_array_free(labels);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(TensorToLabel, max, std::string("max"))->ArgName("outputs")->Arg(2)->Arg(1000);
+BENCHMARK_CAPTURE(TensorToLabel, compound, std::string("compound"))->ArgName("outputs")->Arg(8)->Arg(40);
+BENCHMARK_CAPTURE(TensorToLabel, index, std::string("index"))->ArgName("outputs")->Arg(88);
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include "converters/ssd.h"
+#include "converters/yolo_v2_base.h"
+#include "gva_base_inference.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace Benchmarks;
+using namespace DetectionPlugin::Converters;
+
+namespace {
+
+constexpr guint FRAME_WIDTH = 1920;
+constexpr guint FRAME_HEIGHT = 1080;
+constexpr double CONFIDENCE_THRESHOLD = 0.5;
+constexpr size_t LABELS_NUMBER = 80;
+
+// Single full frame inference request, buffer is replaced before each iteration as converters attach ROIs to it
+class DetectionFixture {
+  public:
+    DetectionFixture()
+        : info(MakeVideoInfo(FRAME_WIDTH, FRAME_HEIGHT)), base_inference(), detection_result(nullptr),
+          labels(g_value_array_new(LABELS_NUMBER)) {
+        base_inference.info = &info;
+        GstVideoRegionOfInterestMeta roi = GstVideoRegionOfInterestMeta();
+        roi.w = FRAME_WIDTH;
+        roi.h = FRAME_HEIGHT;
+        frames.push_back(std::make_shared<InferenceFrame>(gst_buffer_new(), roi, std::vector<GstStructure *>(),
+                                                          &base_inference, &info));
+        detection_result = gst_structure_new_empty("detection");
+
+        GValue label = G_VALUE_INIT;
+        g_value_init(&label, G_TYPE_STRING);
+        for (size_t i = 0; i < LABELS_NUMBER; i++) {
+            g_value_set_string(&label, ("label_" + std::to_string(i)).c_str());
+            g_value_array_append(labels, &label);
+        }
+        g_value_unset(&label);
+    }
+
+    ~DetectionFixture() {
+        gst_buffer_unref(frames.front()->buffer);
+        gst_structure_free(detection_result);
+        g_value_array_free(labels);
+    }
+
+    void ResetBuffer() {
+        gst_buffer_unref(frames.front()->buffer);
+        frames.front()->buffer = gst_buffer_new();
+    }
+
+    GstVideoInfo info;
+    GvaBaseInference base_inference;
+    std::vector<std::shared_ptr<InferenceFrame>> frames;
+    GstStructure *detection_result;
+    GValueArray *labels;
+};
+
+// DetectionOutput layer of 200 proposals, first objects_number of them are above confidence threshold
+void SSDConverterProcess(benchmark::State &state) {
+    constexpr size_t MAX_PROPOSALS = 200;
+    constexpr size_t OBJECT_SIZE = 7;
+    const size_t objects_number = state.range(0);
+    std::vector<float> data(MAX_PROPOSALS * OBJECT_SIZE);
+    for (size_t i = 0; i < MAX_PROPOSALS; i++) {
+        float *object = &data[i * OBJECT_SIZE];
+        const float x_min = RandomFloat(0.f, 0.9f);
+        const float y_min = RandomFloat(0.f, 0.9f);
+        object[0] = 0;
+        object[1] = static_cast<float>(i % LABELS_NUMBER);
+        object[2] = i < objects_number ? RandomFloat(0.5f, 1.f) : RandomFloat(0.f, 0.4f);
+        object[3] = x_min;
+        object[4] = y_min;
+        object[5] = x_min + RandomFloat(0.01f, 0.1f);
+        object[6] = y_min + RandomFloat(0.01f, 0.1f);
+    }
+    std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs = {
+        {"detection_out", std::make_shared<FloatOutputBlob>(std::vector<size_t>{1, 1, MAX_PROPOSALS, OBJECT_SIZE},
+                                                            std::move(data))}};
+    DetectionFixture fixture;
+    SSDConverter converter;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fixture.ResetBuffer();
+        state.ResumeTiming();
+        converter.process(blobs, fixture.frames, fixture.detection_result, CONFIDENCE_THRESHOLD, fixture.labels);
+    }
+    state.SetItemsProcessed(state.iterations() * objects_number);
+}
+
+// YOLO v2 region layer 13x13 cells with 5 boxes per cell and 80 classes, candidates_number of boxes pass threshold
+void YOLOV2ConverterProcess(benchmark::State &state) {
+    constexpr size_t CELLS_NUMBER = 13;
+    constexpr size_t BBOX_NUMBER_ON_CELL = 5;
+    constexpr size_t COMMON_CELLS_NUMBER = CELLS_NUMBER * CELLS_NUMBER;
+    constexpr size_t ONE_BBOX_BLOB_SIZE = LABELS_NUMBER + 5;
+    constexpr size_t ONE_SCALE_BBOXES_BLOB_SIZE = ONE_BBOX_BLOB_SIZE * COMMON_CELLS_NUMBER;
+    const std::vector<float> anchors = {1.08f, 1.19f, 3.42f, 4.41f, 6.63f, 11.38f, 9.42f, 5.11f, 16.62f, 10.52f};
+    const size_t candidates_number = state.range(0);
+
+    std::vector<float> data(ONE_SCALE_BBOXES_BLOB_SIZE * BBOX_NUMBER_ON_CELL);
+    std::vector<size_t> boxes(COMMON_CELLS_NUMBER * BBOX_NUMBER_ON_CELL);
+    for (size_t i = 0; i < boxes.size(); i++)
+        boxes[i] = i;
+    std::shuffle(boxes.begin(), boxes.end(), RandomEngine());
+    for (size_t i = 0; i < boxes.size(); i++) {
+        const size_t offset =
+            boxes[i] / COMMON_CELLS_NUMBER * ONE_SCALE_BBOXES_BLOB_SIZE + boxes[i] % COMMON_CELLS_NUMBER;
+        auto value = [&](size_t index) -> float & { return data[offset + index * COMMON_CELLS_NUMBER]; };
+        value(0) = RandomFloat(0.f, 1.f);
+        value(1) = RandomFloat(0.f, 1.f);
+        value(2) = RandomFloat(-1.f, 0.5f);
+        value(3) = RandomFloat(-1.f, 0.5f);
+        value(4) = i < candidates_number ? RandomFloat(0.6f, 1.f) : RandomFloat(0.f, 0.4f);
+        for (size_t class_id = 0; class_id < LABELS_NUMBER; class_id++)
+            value(5 + class_id) = RandomFloat(0.f, 1.f);
+    }
+    std::vector<size_t> dims = {1, data.size()};
+    std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs = {
+        {"region", std::make_shared<FloatOutputBlob>(std::move(dims), std::move(data))}};
+    DetectionFixture fixture;
+    YOLOV2Converter converter(LABELS_NUMBER, anchors, CELLS_NUMBER, CELLS_NUMBER, 0.5, BBOX_NUMBER_ON_CELL);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fixture.ResetBuffer();
+        state.ResumeTiming();
+        converter.process(blobs, fixture.frames, fixture.detection_result, CONFIDENCE_THRESHOLD, fixture.labels);
+    }
+    state.SetItemsProcessed(state.iterations() * candidates_number);
+}
+
+// Gives access to non-maximum suppression shared by YOLO converters
+class NmsConverter : public YOLOConverter {
+  public:
+    using YOLOConverter::DetectedObject;
+    using YOLOConverter::runNms;
+
+    NmsConverter() : YOLOConverter(std::vector<float>(), 0.5) {
+    }
+
+    bool process(const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &,
+                 const std::vector<std::shared_ptr<InferenceFrame>> &, GstStructure *, double,
+                 GValueArray *) override {
+        return false;
+    }
+};
+
+void YOLORunNms(benchmark::State &state) {
+    const size_t candidates_number = state.range(0);
+    std::vector<NmsConverter::DetectedObject> candidates;
+    candidates.reserve(candidates_number);
+    for (size_t i = 0; i < candidates_number; i++)
+        candidates.emplace_back(RandomFloat(0.f, 1.f), RandomFloat(0.f, 1.f), RandomFloat(0.02f, 0.2f),
+                                RandomFloat(0.02f, 0.2f), i % LABELS_NUMBER, RandomFloat(0.5f, 1.f));
+    NmsConverter converter;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<NmsConverter::DetectedObject> objects = candidates;
+        state.ResumeTiming();
+        converter.runNms(objects);
+        benchmark::DoNotOptimize(objects.data());
+    }
+    state.SetItemsProcessed(state.iterations() * candidates_number);
+    state.SetComplexityN(candidates_number);
+}
+
+} // namespace
+
+BENCHMARK(SSDConverterProcess)->ArgName("objects")->Arg(1)->Arg(10)->Arg(100)->Arg(200);
+BENCHMARK(YOLOV2ConverterProcess)->ArgName("candidates")->Arg(10)->Arg(100)->Arg(845);
+BENCHMARK(YOLORunNms)->ArgName("candidates")->RangeMultiplier(10)->Range(100, 10000)->Complexity();
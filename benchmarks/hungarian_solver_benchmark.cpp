@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include "hungarian_solver.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Benchmarks;
+
+namespace {
+
+constexpr size_t MAX_SIZE = 7;
+
+// Exhaustive search over all assignments of the smaller dimension, reference for HungarianSolver
+template <typename Cost>
+class BruteForceSolver {
+  public:
+    BruteForceSolver(const std::vector<Cost> &costs, size_t rows, size_t cols)
+        : costs(costs), rows(rows), cols(cols), used(std::max(rows, cols), false) {
+    }
+
+    double MinTotalCost() {
+        best = std::numeric_limits<double>::max();
+        Search(0, 0.);
+        return best;
+    }
+
+  private:
+    // assigns element k of the smaller dimension to every free element of the larger one
+    void Search(size_t k, double total) {
+        const size_t n = std::min(rows, cols);
+        const size_t m = std::max(rows, cols);
+        if (k == n) {
+            best = std::min(best, total);
+            return;
+        }
+        for (size_t j = 0; j < m; j++) {
+            if (used[j])
+                continue;
+            used[j] = true;
+            const Cost cost = rows <= cols ? costs[k * cols + j] : costs[j * cols + k];
+            Search(k + 1, total + static_cast<double>(cost));
+            used[j] = false;
+        }
+    }
+
+    const std::vector<Cost> &costs;
+    const size_t rows, cols;
+    std::vector<bool> used;
+    double best = 0.;
+};
+
+// Costs of small range produce many ties, full range checks overflow of the dual variables
+template <typename Cost>
+Cost RandomCost(bool ties);
+
+template <>
+int16_t RandomCost<int16_t>(bool ties) {
+    return ties ? std::uniform_int_distribution<int16_t>(0, 3)(RandomEngine())
+                : std::uniform_int_distribution<int16_t>(std::numeric_limits<int16_t>::min(),
+                                                         std::numeric_limits<int16_t>::max())(RandomEngine());
+}
+
+template <>
+int64_t RandomCost<int64_t>(bool ties) {
+    constexpr int64_t LIMIT = 1000000000000LL;
+    return ties ? std::uniform_int_distribution<int64_t>(0, 3)(RandomEngine())
+                : std::uniform_int_distribution<int64_t>(-LIMIT, LIMIT)(RandomEngine());
+}
+
+template <>
+float RandomCost<float>(bool ties) {
+    // quarters are exact in float, so tied assignments have exactly equal totals
+    return ties ? std::uniform_int_distribution<int>(0, 4)(RandomEngine()) / 4.f : RandomFloat(-1.f, 1.f);
+}
+
+// Checks that assignment is a matching of min(rows, cols) pairs and returns its total cost
+template <typename Cost>
+bool AssignmentCost(const std::vector<Cost> &costs, size_t rows, size_t cols, const std::vector<size_t> &row_to_col,
+                    double &total) {
+    if (row_to_col.size() != rows)
+        return false;
+    std::vector<bool> used(cols, false);
+    size_t assigned = 0;
+    total = 0.;
+    for (size_t row = 0; row < rows; row++) {
+        const size_t col = row_to_col[row];
+        if (col == iou::HungarianSolver<Cost>::kNoAssignment)
+            continue;
+        if (col >= cols || used[col])
+            return false;
+        used[col] = true;
+        assigned++;
+        total += static_cast<double>(costs[row * cols + col]);
+    }
+    return assigned == std::min(rows, cols);
+}
+
+// Solves random rectangular problems, both wide and tall (solved transposed), and compares total cost of the
+// assignment with exhaustive search. Reports error on the first mismatch. Timing includes the exhaustive search, so
+// it is not meaningful, the benchmark is a correctness check of the solver
+template <typename Cost>
+void HungarianSolverCheck(benchmark::State &state) {
+    iou::HungarianSolver<Cost> solver;
+    std::vector<Cost> costs;
+    std::vector<size_t> row_to_col;
+    size_t problems = 0;
+
+    for (auto _ : state) {
+        const size_t rows = std::uniform_int_distribution<size_t>(1, MAX_SIZE)(RandomEngine());
+        const size_t cols = std::uniform_int_distribution<size_t>(1, MAX_SIZE)(RandomEngine());
+        const bool ties = problems % 2 == 0;
+        costs.resize(rows * cols);
+        for (Cost &cost : costs)
+            cost = RandomCost<Cost>(ties);
+
+        solver.Solve(costs.data(), rows, cols, row_to_col);
+        problems++;
+
+        double total = 0.;
+        if (!AssignmentCost(costs, rows, cols, row_to_col, total)) {
+            state.SkipWithError(("Invalid assignment of " + std::to_string(rows) + "x" + std::to_string(cols) +
+                                 " matrix")
+                                    .c_str());
+            break;
+        }
+        const double expected = BruteForceSolver<Cost>(costs, rows, cols).MinTotalCost();
+        const double tolerance = std::is_floating_point<Cost>::value ? 1e-5 * (1. + std::fabs(expected)) : 0.;
+        if (std::fabs(total - expected) > tolerance) {
+            state.SkipWithError(("Assignment of " + std::to_string(rows) + "x" + std::to_string(cols) +
+                                 " matrix is not optimal: total cost " + std::to_string(total) + ", expected " +
+                                 std::to_string(expected))
+                                    .c_str());
+            break;
+        }
+    }
+    state.counters["problems"] = problems;
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(HungarianSolverCheck, int16_t)->Iterations(5000);
+BENCHMARK_TEMPLATE(HungarianSolverCheck, int64_t)->Iterations(5000);
+BENCHMARK_TEMPLATE(HungarianSolverCheck, float)->Iterations(5000);
@@ -0,0 +1,18 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <gst/gst.h>
+
+// Same as BENCHMARK_MAIN(), but GStreamer is initialized first because most of benchmarks create buffers and metas
+int main(int argc, char **argv) {
+    gst_init(&argc, &argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
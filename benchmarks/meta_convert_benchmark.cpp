@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include "jsonconverter.h"
+#include "video_frame.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace Benchmarks;
+
+namespace {
+
+constexpr guint FRAME_WIDTH = 1920;
+constexpr guint FRAME_HEIGHT = 1080;
+
+// Frame after detection and two classification models, as in face detection and attributes recognition pipeline
+GstBuffer *MakeFrame(GstVideoInfo *info, size_t objects_number) {
+    GstBuffer *buffer = gst_buffer_new();
+    GST_BUFFER_PTS(buffer) = 40 * GST_MSECOND;
+    GVA::VideoFrame frame(buffer, info);
+    for (size_t i = 0; i < objects_number; i++) {
+        GVA::RegionOfInterest roi = frame.add_region(RandomFloat(0.f, 0.9f), RandomFloat(0.f, 0.9f), 0.05, 0.1, "face",
+                                                     RandomFloat(0.5f, 1.f), true);
+        GVA::Tensor age = roi.add_tensor("age");
+        age.set_string("label", std::to_string(20 + i % 50));
+        age.set_string("model_name", "age-gender-recognition");
+        age.set_string("layer_name", "age_conv3");
+        GVA::Tensor emotion = roi.add_tensor("emotion");
+        emotion.set_string("label", "neutral");
+        emotion.set_double("confidence", RandomFloat(0.5f, 1.f));
+        emotion.set_int("label_id", 0);
+        emotion.set_string("model_name", "emotions-recognition");
+        emotion.set_string("layer_name", "prob_emotion");
+    }
+    return buffer;
+}
+
+void MetaConvertToJson(benchmark::State &state) {
+    const size_t objects_number = state.range(0);
+    GstVideoInfo info = MakeVideoInfo(FRAME_WIDTH, FRAME_HEIGHT);
+    GstGvaMetaConvert *converter = GST_GVA_META_CONVERT(g_object_new(GST_TYPE_GVA_META_CONVERT, NULL));
+    g_object_set(converter, "source", "file:///video.mp4", "tags", "{\"camera\": \"entrance\"}", NULL);
+    // state of element that received caps and time segment, video info is borrowed from the benchmark
+    gst_segment_init(&converter->base_gvametaconvert.segment, GST_FORMAT_TIME);
+    converter->info = &info;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        GstBuffer *buffer = MakeFrame(&info, objects_number);
+        state.ResumeTiming();
+        if (!to_json(converter, buffer))
+            state.SkipWithError("Failed to convert metadata to JSON");
+        state.PauseTiming();
+        gst_buffer_unref(buffer);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * objects_number);
+
+    converter->info = nullptr;
+    g_object_unref(converter);
+}
+
+} // namespace
+
+BENCHMARK(MetaConvertToJson)->ArgName("objects")->Arg(1)->Arg(10)->Arg(100);
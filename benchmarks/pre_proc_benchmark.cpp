@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "inference_backend/pre_proc.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace InferenceBackend;
+
+namespace {
+
+constexpr uint32_t NETWORK_INPUT_SIZE = 300;
+
+// Frame of given format in system memory, planes are laid out contiguously without padding
+struct SystemImage {
+    std::vector<uint8_t> data;
+    Image image;
+
+    SystemImage(int format, uint32_t width, uint32_t height) : image() {
+        image.type = MemoryType::SYSTEM;
+        image.format = format;
+        image.width = width;
+        image.height = height;
+        const size_t area = static_cast<size_t>(width) * height;
+        switch (format) {
+        case FOURCC_BGRX:
+            data.resize(area * 4);
+            image.planes[0] = data.data();
+            image.stride[0] = width * 4;
+            break;
+        case FOURCC_NV12:
+            data.resize(area * 3 / 2);
+            image.planes[0] = data.data();
+            image.planes[1] = image.planes[0] + area;
+            image.stride[0] = image.stride[1] = width;
+            break;
+        case FOURCC_I420:
+            data.resize(area * 3 / 2);
+            image.planes[0] = data.data();
+            image.planes[1] = image.planes[0] + area;
+            image.planes[2] = image.planes[1] + area / 4;
+            image.stride[0] = width;
+            image.stride[1] = image.stride[2] = width / 2;
+            break;
+        case FOURCC_RGBP:
+            data.resize(area * 3);
+            for (int i = 0; i < 3; i++) {
+                image.planes[i] = data.data() + i * area;
+                image.stride[i] = width;
+            }
+            break;
+        }
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = static_cast<uint8_t>(i * 7);
+    }
+};
+
+void OpenCVConvert(benchmark::State &state, int format) {
+    const uint32_t width = state.range(0);
+    const uint32_t height = state.range(1);
+    SystemImage src(format, width, height);
+    SystemImage dst(FOURCC_RGBP, NETWORK_INPUT_SIZE, NETWORK_INPUT_SIZE);
+    std::unique_ptr<PreProc> pre_proc(PreProc::Create(PreProcessType::OpenCV));
+
+    for (auto _ : state) {
+        pre_proc->Convert(src.image, dst.image);
+        benchmark::DoNotOptimize(dst.data.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * src.data.size());
+}
+
+void FrameSizes(benchmark::internal::Benchmark *bench) {
+    bench->ArgNames({"width", "height"});
+    bench->Args({1280, 720});
+    bench->Args({1920, 1080});
+    bench->Args({3840, 2160});
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(OpenCVConvert, BGRx, FOURCC_BGRX)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(OpenCVConvert, NV12, FOURCC_NV12)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(OpenCVConvert, I420, FOURCC_I420)->Apply(FrameSizes)->Unit(benchmark::kMicrosecond);
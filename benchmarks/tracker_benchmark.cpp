@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include "gva_utils.h"
+#include "kuhn_munkres.h"
+#include "tracker.h"
+#include "video_frame.h"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include <unistd.h>
+
+using namespace Benchmarks;
+
+namespace {
+
+constexpr int FRAME_WIDTH = 1920;
+constexpr int FRAME_HEIGHT = 1080;
+constexpr int OBJECT_WIDTH = 24;
+constexpr int OBJECT_HEIGHT = 36;
+
+// Crowd of objects placed on a grid, each object moves with its own constant velocity of up to 2 pixels per frame.
+// If respawn period is set, each object leaves the scene once per period and a new one appears at random position
+class Crowd {
+  public:
+    explicit Crowd(size_t objects_number, size_t respawn_period = 0) : respawn_period(respawn_period), frame(0) {
+        const int columns = FRAME_WIDTH / (OBJECT_WIDTH * 5 / 4);
+        for (size_t i = 0; i < objects_number; i++) {
+            Object object;
+            object.x = static_cast<float>(i % columns * OBJECT_WIDTH * 5 / 4);
+            object.y = static_cast<float>(i / columns * OBJECT_HEIGHT * 5 / 4);
+            object.dx = RandomFloat(-2.f, 2.f);
+            object.dy = RandomFloat(-2.f, 2.f);
+            object.respawn_phase = respawn_period ? i * respawn_period / objects_number : 0;
+            objects.push_back(object);
+        }
+    }
+
+    // Detections of the next frame, objects reaching frame border bounce back
+    GstBuffer *NextFrame(GstVideoInfo *info) {
+        GstBuffer *buffer = gst_buffer_new();
+        GVA::VideoFrame video_frame(buffer, info);
+        for (Object &object : objects) {
+            if (respawn_period && frame % respawn_period == object.respawn_phase) {
+                object.x = RandomFloat(0.f, FRAME_WIDTH - OBJECT_WIDTH);
+                object.y = RandomFloat(0.f, FRAME_HEIGHT - OBJECT_HEIGHT);
+            }
+            object.x += object.dx;
+            object.y += object.dy;
+            if (object.x < 0 || object.x + OBJECT_WIDTH > FRAME_WIDTH)
+                object.dx = -object.dx;
+            if (object.y < 0 || object.y + OBJECT_HEIGHT > FRAME_HEIGHT)
+                object.dy = -object.dy;
+            video_frame.add_region(object.x, object.y, OBJECT_WIDTH, OBJECT_HEIGHT, "face", 0.9);
+        }
+        frame++;
+        return buffer;
+    }
+
+  private:
+    struct Object {
+        float x, y;
+        float dx, dy;
+        size_t respawn_phase;
+    };
+    std::vector<Object> objects;
+    const size_t respawn_period;
+    size_t frame;
+};
+
+void IOUTrackerTrack(benchmark::State &state) {
+    const size_t objects_number = state.range(0);
+    GstVideoInfo info = MakeVideoInfo(FRAME_WIDTH, FRAME_HEIGHT);
+    iou::Tracker tracker(&info);
+    Crowd crowd(objects_number);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        GstBuffer *buffer = crowd.NextFrame(&info);
+        state.ResumeTiming();
+        tracker.track(buffer);
+        state.PauseTiming();
+        gst_buffer_unref(buffer);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * objects_number);
+    state.SetComplexityN(objects_number);
+}
+
+size_t ResidentSetSizeKb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+// 24 hours of 30 fps stream where every object is replaced by a new one each 10 seconds, so about 170 thousand
+// tracks are created and forgotten. Resident set size after the first hour and at the end of the stream shows whether
+// memory of the tracker stays bounded. Time includes generation of detections
+void IOUTrackerLongRun(benchmark::State &state) {
+    constexpr size_t FPS = 30;
+    constexpr size_t FRAMES_PER_HOUR = 3600 * FPS;
+    const size_t objects_number = state.range(0);
+    GstVideoInfo info = MakeVideoInfo(FRAME_WIDTH, FRAME_HEIGHT);
+    iou::Tracker tracker(&info);
+    Crowd crowd(objects_number, 10 * FPS);
+    size_t frames = 0;
+
+    for (auto _ : state) {
+        GstBuffer *buffer = crowd.NextFrame(&info);
+        tracker.track(buffer);
+        gst_buffer_unref(buffer);
+        if (++frames == FRAMES_PER_HOUR)
+            state.counters["rss_1h_kb"] = ResidentSetSizeKb();
+    }
+    state.counters["rss_end_kb"] = ResidentSetSizeKb();
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Frame on which inference was skipped is copied before tracking, as done by tee branch or by in-place element that
+// receives shared buffer. Skip mark must survive the copy: tracker fed with copies predicts the same boxes of live
+// tracks as tracker fed with original frames, instead of treating copied frame as frame without detections. Reports
+// error on mismatch
+void IOUTrackerSkippedFrameCopyCheck(benchmark::State &state) {
+    constexpr int INFERENCE_INTERVAL = 3;
+    const size_t objects_number = state.range(0);
+    GstVideoInfo info = MakeVideoInfo(FRAME_WIDTH, FRAME_HEIGHT);
+    iou::Tracker original_tracker(&info);
+    iou::Tracker copy_tracker(&info);
+    Crowd crowd(objects_number);
+    size_t frame = 0;
+    size_t predicted_total = 0;
+
+    for (auto _ : state) {
+        const bool skipped = frame++ % INFERENCE_INTERVAL != 0;
+        GstBuffer *original = skipped ? gst_buffer_new() : crowd.NextFrame(&info);
+        gva_buffer_set_inference_skipped(original, skipped);
+        GstBuffer *copy = gst_buffer_copy(original);
+        original_tracker.track(original);
+        copy_tracker.track(copy);
+        const size_t expected = GVA::VideoFrame(original, &info).regions().size();
+        const size_t predicted = GVA::VideoFrame(copy, &info).regions().size();
+        gst_buffer_unref(original);
+        gst_buffer_unref(copy);
+        if (skipped)
+            predicted_total += predicted;
+        if (predicted != expected) {
+            state.SkipWithError(("Tracker predicted " + std::to_string(predicted) + " boxes on copied frame, " +
+                                 std::to_string(expected) + " on original frame")
+                                    .c_str());
+            return;
+        }
+    }
+    if (predicted_total == 0)
+        state.SkipWithError("Tracker predicted no boxes on skipped frames");
+}
+
+void KuhnMunkresSolve(benchmark::State &state) {
+    const int size = state.range(0);
+    cv::Mat dissimilarity(size, size, CV_32F);
+    for (int row = 0; row < size; row++)
+        for (int col = 0; col < size; col++)
+            dissimilarity.at<float>(row, col) = RandomFloat(0.f, 1.f);
+    iou::KuhnMunkres solver;
+
+    for (auto _ : state) {
+        std::vector<size_t> assignment = solver.Solve(dissimilarity);
+        benchmark::DoNotOptimize(assignment.data());
+    }
+    state.SetComplexityN(size);
+}
+
+} // namespace
+
+BENCHMARK(IOUTrackerTrack)->ArgName("objects")->Arg(10)->Arg(100)->Arg(1000)->Complexity();
+BENCHMARK(IOUTrackerLongRun)->ArgName("objects")->Arg(20)->Iterations(24 * 3600 * 30)->Unit(benchmark::kMillisecond);
+BENCHMARK(IOUTrackerSkippedFrameCopyCheck)->ArgName("objects")->Arg(10)->Iterations(300);
+BENCHMARK(KuhnMunkresSolve)->ArgName("size")->RangeMultiplier(4)->Range(8, 512)->Complexity();
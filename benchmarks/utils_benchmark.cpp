@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "GenericByteData.h"
+#include "lru_cache.h"
+#include "pool_allocator.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Access pattern of classification history: on every frame each visible object is looked up by its id and inserted
+// if it is new, one object leaves the scene and a new one appears per frame
+void LRUCacheLookup(benchmark::State &state) {
+    constexpr size_t CACHE_SIZE = 100;
+    const unsigned visible_objects = state.range(0);
+    LRUCache<int, unsigned> cache(CACHE_SIZE);
+    unsigned frame = 0;
+
+    for (auto _ : state) {
+        for (unsigned i = 0; i < visible_objects; i++) {
+            const int id = frame + i;
+            if (cache.count(id) == 0)
+                cache.put(id, frame);
+            else
+                benchmark::DoNotOptimize(cache.get(id));
+        }
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations() * visible_objects);
+}
+
+// Header of received frame is parsed in place, without copy of the payload
+void GenericByteDataParse(benchmark::State &state) {
+    const size_t body_length = state.range(0);
+    std::vector<unsigned char> payload(body_length, 0x5a);
+    VpsUtilities::GenericByteData source(payload.data(), payload.size(), true, true);
+    source.SetDataType(VpsUtilities::DataType::VIDEO);
+    source.SetCodec(VpsUtilities::Codec::H264);
+    source.SetSequenceNumber(42);
+    source.SetTimeStamp(1600000000000ull);
+    std::vector<unsigned char> frame(source.GetData(), source.GetData() + source.GetLength());
+
+    for (auto _ : state) {
+        VpsUtilities::GenericByteData data(frame.data(), frame.size());
+        benchmark::DoNotOptimize(data.GetDataType());
+        benchmark::DoNotOptimize(data.GetCodec());
+        benchmark::DoNotOptimize(data.GetSequenceNumber());
+        benchmark::DoNotOptimize(data.GetFlags());
+        benchmark::DoNotOptimize(data.GetSyncTimeStamp());
+        benchmark::DoNotOptimize(data.GetTimeStamp());
+        benchmark::DoNotOptimize(data.GetBody());
+        benchmark::DoNotOptimize(data.GetBodyLength());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Frame to send is built by copying payload after generated header
+void GenericByteDataBuild(benchmark::State &state) {
+    const size_t body_length = state.range(0);
+    std::vector<unsigned char> payload(body_length, 0x5a);
+    uint16_t sequence_number = 0;
+
+    for (auto _ : state) {
+        VpsUtilities::GenericByteData data(payload.data(), payload.size(), true, true);
+        data.SetDataType(VpsUtilities::DataType::VIDEO);
+        data.SetCodec(VpsUtilities::Codec::H264);
+        data.SetSequenceNumber(sequence_number++);
+        data.SetTimeStamp(1600000000000ull + sequence_number);
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * body_length);
+}
+
+// Size of per-frame inference objects allocated with PoolAllocator
+struct FrameObject {
+    uint64_t fields[24];
+};
+
+// Allocations of HeapAllocator of all types, std::allocate_shared rebinds allocator to its control block type
+size_t &HeapAllocatorAllocations() {
+    static size_t allocations = 0;
+    return allocations;
+}
+
+// Plain heap allocation as done by std::make_shared, counts allocations for comparison with pool statistics
+template <typename T>
+struct HeapAllocator {
+    using value_type = T;
+
+    HeapAllocator() = default;
+
+    template <typename U>
+    HeapAllocator(const HeapAllocator<U> &) {
+    }
+
+    T *allocate(size_t n) {
+        HeapAllocatorAllocations()++;
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t) {
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const HeapAllocator<U> &) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const HeapAllocator<U> &) const {
+        return false;
+    }
+};
+
+template <typename Allocator>
+size_t HeapAllocations();
+
+template <>
+size_t HeapAllocations<HeapAllocator<FrameObject>>() {
+    return HeapAllocatorAllocations();
+}
+
+template <>
+size_t HeapAllocations<Utils::PoolAllocator<FrameObject>>() {
+    return Utils::GetPoolStats().heap_allocations.load();
+}
+
+// Shared objects created per frame and released once the frame leaves the pipeline, with given number of frames in
+// flight (inference requests). Reports heap allocations per created object, which is about zero for the pool in
+// steady state and one for plain allocation
+template <typename Allocator>
+void SharedObjectAllocation(benchmark::State &state) {
+    const size_t frames_in_flight = state.range(0);
+    std::vector<std::shared_ptr<FrameObject>> in_flight(frames_in_flight);
+    size_t next = 0;
+    const size_t allocations_before = HeapAllocations<Allocator>();
+
+    for (auto _ : state) {
+        in_flight[next] = std::allocate_shared<FrameObject>(Allocator());
+        benchmark::DoNotOptimize(in_flight[next].get());
+        next = (next + 1) % frames_in_flight;
+    }
+    state.counters["heap_allocations"] = benchmark::Counter(
+        static_cast<double>(HeapAllocations<Allocator>() - allocations_before), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(LRUCacheLookup)->ArgName("objects")->Arg(10)->Arg(100)->Arg(200);
+BENCHMARK(GenericByteDataParse)->ArgName("body")->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK(GenericByteDataBuild)->ArgName("body")->Arg(4 << 10)->Arg(64 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(SharedObjectAllocation, Utils::PoolAllocator<FrameObject>)->ArgName("in_flight")->Arg(4)->Arg(64);
+BENCHMARK_TEMPLATE(SharedObjectAllocation, HeapAllocator<FrameObject>)->ArgName("in_flight")->Arg(4)->Arg(64);
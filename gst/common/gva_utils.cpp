@@ -14,4 +14,52 @@ gboolean get_object_id(GstVideoRegionOfInterestMeta *meta, int *id) {
 void set_object_id(GstVideoRegionOfInterestMeta *meta, gint id) {
     GstStructure *object_id = gst_structure_new("object_id", "id", G_TYPE_INT, id, NULL);
     gst_video_region_of_interest_meta_add_param(meta, object_id);
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Mark has no data, presence of the meta on buffer means inference was skipped
+struct GvaInferenceSkippedMeta {
+    GstMeta meta;
+};
+
+GType gva_inference_skipped_meta_api_get_type() {
+    // no tags: mark does not depend on frame content, so it is kept by copies and by conversions of any kind
+    static const gchar *tags[] = {NULL};
+    static const GType type = gst_meta_api_type_register("GvaInferenceSkippedMetaAPI", tags);
+    return type;
+}
+
+gboolean gva_inference_skipped_meta_init(GstMeta *, gpointer, GstBuffer *) {
+    return TRUE;
+}
+
+const GstMetaInfo *gva_inference_skipped_meta_get_info();
+
+gboolean gva_inference_skipped_meta_transform(GstBuffer *dest_buf, GstMeta *, GstBuffer *, GQuark, gpointer) {
+    if (!gst_buffer_get_meta(dest_buf, gva_inference_skipped_meta_api_get_type()))
+        gst_buffer_add_meta(dest_buf, gva_inference_skipped_meta_get_info(), NULL);
+    return TRUE;
+}
+
+const GstMetaInfo *gva_inference_skipped_meta_get_info() {
+    static const GstMetaInfo *meta_info =
+        gst_meta_register(gva_inference_skipped_meta_api_get_type(), "GvaInferenceSkippedMeta",
+                          sizeof(GvaInferenceSkippedMeta), gva_inference_skipped_meta_init, NULL,
+                          gva_inference_skipped_meta_transform);
+    return meta_info;
+}
+
+} // namespace
+
+void gva_buffer_set_inference_skipped(GstBuffer *buffer, gboolean skipped) {
+    GstMeta *meta = gst_buffer_get_meta(buffer, gva_inference_skipped_meta_api_get_type());
+    if (skipped && !meta)
+        gst_buffer_add_meta(buffer, gva_inference_skipped_meta_get_info(), NULL);
+    else if (!skipped && meta)
+        gst_buffer_remove_meta(buffer, meta);
+}
+
+gboolean gva_buffer_is_inference_skipped(GstBuffer *buffer) {
+    return gst_buffer_get_meta(buffer, gva_inference_skipped_meta_api_get_type()) != NULL;
+}
@@ -16,6 +16,13 @@ G_BEGIN_DECLS
 gboolean get_object_id(GstVideoRegionOfInterestMeta *meta, int *id);
 void set_object_id(GstVideoRegionOfInterestMeta *meta, gint id);
 
+/* Full-frame inference elements mark every frame passed downstream, so that tracker can tell frame on which inference
+ * was skipped (inference-interval, adaptive-interval, no-block) from frame without detections. Mark is stored as
+ * GstMeta without tags, so it is kept when buffer is copied (e.g. by tee branch or to make buffer writable).
+ * Buffer must be writable to set the mark */
+void gva_buffer_set_inference_skipped(GstBuffer *buffer, gboolean skipped);
+gboolean gva_buffer_is_inference_skipped(GstBuffer *buffer);
+
 G_END_DECLS
 
 #define GST_VIDEO_REGION_OF_INTEREST_META_ITERATE(buf, state)                                                          \
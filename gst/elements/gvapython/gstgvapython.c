@@ -19,7 +19,16 @@
 GST_DEBUG_CATEGORY_STATIC(gst_gva_python_debug_category);
 #define GST_CAT_DEFAULT gst_gva_python_debug_category
 
-enum { PROP_0, PROP_MODULE, PROP_CLASS, PROP_FUNCTION, PROP_ARGUMENT, PROP_KW_ARGUMENT };
+enum {
+    PROP_0,
+    PROP_MODULE,
+    PROP_CLASS,
+    PROP_FUNCTION,
+    PROP_ARGUMENT,
+    PROP_KW_ARGUMENT,
+    PROP_BATCH_SIZE,
+    PROP_BATCH_TIMEOUT
+};
 
 #define DEFAULT_MODULE ""
 #define DEFAULT_CLASS ""
@@ -27,6 +36,14 @@ enum { PROP_0, PROP_MODULE, PROP_CLASS, PROP_FUNCTION, PROP_ARGUMENT, PROP_KW_AR
 #define DEFAULT_ARGUMENT "[]"
 #define DEFAULT_KW_ARGUMENT "{}"
 
+#define DEFAULT_MIN_BATCH_SIZE 1
+#define DEFAULT_MAX_BATCH_SIZE 1024
+#define DEFAULT_BATCH_SIZE 1
+
+#define DEFAULT_MIN_BATCH_TIMEOUT 0
+#define DEFAULT_MAX_BATCH_TIMEOUT G_MAXUINT
+#define DEFAULT_BATCH_TIMEOUT 0
+
 #ifdef NDEBUG
 #define LOG_PYTHON_ERROR(ELEMENT, ...) GST_ERROR_OBJECT(ELEMENT, __VA_ARGS__)
 #else
@@ -40,10 +57,16 @@ static void gst_gva_python_set_property(GObject *object, guint property_id, cons
 static void gst_gva_python_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean gst_gva_python_set_caps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps);
 static gboolean gst_gva_python_start(GstBaseTransform *trans);
+static gboolean gst_gva_python_stop(GstBaseTransform *trans);
+static gboolean gst_gva_python_sink_event(GstBaseTransform *trans, GstEvent *event);
+static gboolean gst_gva_python_query(GstBaseTransform *trans, GstPadDirection direction, GstQuery *query);
 static void gst_gva_python_dispose(GObject *object);
 static void gst_gva_python_finalize(GObject *object);
 
 static GstFlowReturn gst_gva_python_transform_ip(GstBaseTransform *trans, GstBuffer *buf);
+static GstFlowReturn gst_gva_python_process_batch(GstGvaPython *gvapython, GstBuffer *current);
+static void gst_gva_python_clear_batch(GstGvaPython *gvapython);
+static GstClockTime gst_gva_python_batch_hold_time(GstGvaPython *gvapython);
 
 /* class initialization */
 static void gst_gva_python_init(GstGvaPython *gva_python);
@@ -69,6 +92,9 @@ static void gst_gva_python_class_init(GstGvaPythonClass *klass) {
     gobject_class->dispose = gst_gva_python_dispose;
     gobject_class->finalize = gst_gva_python_finalize;
     base_transform_class->start = GST_DEBUG_FUNCPTR(gst_gva_python_start);
+    base_transform_class->stop = GST_DEBUG_FUNCPTR(gst_gva_python_stop);
+    base_transform_class->sink_event = GST_DEBUG_FUNCPTR(gst_gva_python_sink_event);
+    base_transform_class->query = GST_DEBUG_FUNCPTR(gst_gva_python_query);
     base_transform_class->set_caps = GST_DEBUG_FUNCPTR(gst_gva_python_set_caps);
     base_transform_class->transform = NULL;
     base_transform_class->transform_ip = GST_DEBUG_FUNCPTR(gst_gva_python_transform_ip);
@@ -103,6 +129,25 @@ static void gst_gva_python_class_init(GstGvaPythonClass *klass) {
     g_object_class_install_property(gobject_class, PROP_FUNCTION,
                                     g_param_spec_string("function", "Python function name", "Python function name",
                                                         DEFAULT_FUNCTION, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_SIZE,
+        g_param_spec_uint("batch-size", "Batch size",
+                          "Number of frames passed to Python function in one call. If greater than 1, function "
+                          "receives list of gstgva.VideoFrame and returns either one value for all frames or "
+                          "list with value for each frame. Frames with false value are dropped. "
+                          "If 1, function is called for each frame with single gstgva.VideoFrame",
+                          DEFAULT_MIN_BATCH_SIZE, DEFAULT_MAX_BATCH_SIZE, DEFAULT_BATCH_SIZE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_TIMEOUT,
+        g_param_spec_uint("batch-timeout", "Batch timeout",
+                          "Maximum time in milliseconds first frame of incomplete batch waits for Python function "
+                          "call. Checked on arrival of next frame, incomplete batch is also processed on "
+                          "serialized events like EOS. 0 means wait for full batch",
+                          DEFAULT_MIN_BATCH_TIMEOUT, DEFAULT_MAX_BATCH_TIMEOUT, DEFAULT_BATCH_TIMEOUT,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void gst_gva_python_init(GstGvaPython *gvapython) {
@@ -112,6 +157,11 @@ static void gst_gva_python_init(GstGvaPython *gvapython) {
     create_arguments(&gvapython->args, &gvapython->kwargs);
     gvapython->function_name = g_strdup(DEFAULT_FUNCTION);
     gvapython->python_callback = NULL;
+    gvapython->batch_size = DEFAULT_BATCH_SIZE;
+    gvapython->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+    gvapython->batch = g_ptr_array_new();
+    gvapython->batch_start = 0;
+    gvapython->frame_duration = GST_CLOCK_TIME_NONE;
 }
 
 void gst_gva_python_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec) {
@@ -138,6 +188,12 @@ void gst_gva_python_get_property(GObject *object, guint property_id, GValue *val
         g_value_set_string(value, argument_string);
         g_free(argument_string);
         break;
+    case PROP_BATCH_SIZE:
+        g_value_set_uint(value, gvapython->batch_size);
+        break;
+    case PROP_BATCH_TIMEOUT:
+        g_value_set_uint(value, gvapython->batch_timeout);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -173,6 +229,18 @@ void gst_gva_python_set_property(GObject *object, guint property_id, const GValu
                               ("%s is invalid JSON", g_value_get_string(value)));
         }
         break;
+    case PROP_BATCH_SIZE:
+        GST_OBJECT_LOCK(gvapython);
+        gvapython->batch_size = g_value_get_uint(value);
+        GST_OBJECT_UNLOCK(gvapython);
+        gst_element_post_message(GST_ELEMENT(gvapython), gst_message_new_latency(GST_OBJECT(gvapython)));
+        break;
+    case PROP_BATCH_TIMEOUT:
+        GST_OBJECT_LOCK(gvapython);
+        gvapython->batch_timeout = g_value_get_uint(value);
+        GST_OBJECT_UNLOCK(gvapython);
+        gst_element_post_message(GST_ELEMENT(gvapython), gst_message_new_latency(GST_OBJECT(gvapython)));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -209,13 +277,80 @@ static gboolean gst_gva_python_start(GstBaseTransform *trans) {
     return gvapython->python_callback != NULL;
 }
 
+static gboolean gst_gva_python_stop(GstBaseTransform *trans) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+    GST_DEBUG_OBJECT(gvapython, "stop");
+    // pads are already deactivated, so frames of incomplete batch can't be pushed
+    gst_gva_python_clear_batch(gvapython);
+    return TRUE;
+}
+
+static gboolean gst_gva_python_sink_event(GstBaseTransform *trans, GstEvent *event) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+
+    GST_DEBUG_OBJECT(gvapython, "sink_event %s", GST_EVENT_TYPE_NAME(event));
+
+    if (GST_EVENT_TYPE(event) == GST_EVENT_FLUSH_STOP) {
+        gst_gva_python_clear_batch(gvapython);
+    } else if (GST_EVENT_IS_SERIALIZED(event) && gvapython->batch->len > 0) {
+        // frames of incomplete batch must go downstream before serialized events (EOS, segment, caps, ...)
+        GstFlowReturn ret = gst_gva_python_process_batch(gvapython, NULL);
+        if (ret != GST_FLOW_OK)
+            GST_WARNING_OBJECT(gvapython, "Processing batch returned status %s", gst_flow_get_name(ret));
+    }
+
+    return GST_BASE_TRANSFORM_CLASS(gst_gva_python_parent_class)->sink_event(trans, event);
+}
+
 static gboolean gst_gva_python_set_caps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps) {
     UNUSED(outcaps);
     GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
     GST_DEBUG_OBJECT(gvapython, "set_caps");
+
+    GstClockTime frame_duration = GST_CLOCK_TIME_NONE;
+    gint fps_n = 0, fps_d = 1;
+    if (gst_caps_get_size(incaps) > 0 &&
+        gst_structure_get_fraction(gst_caps_get_structure(incaps, 0), "framerate", &fps_n, &fps_d) && fps_n > 0)
+        frame_duration = gst_util_uint64_scale_int(GST_SECOND, fps_d, fps_n);
+    GST_OBJECT_LOCK(gvapython);
+    gboolean changed = frame_duration != gvapython->frame_duration;
+    gvapython->frame_duration = frame_duration;
+    GST_OBJECT_UNLOCK(gvapython);
+    if (changed && gvapython->batch_size > 1)
+        gst_element_post_message(GST_ELEMENT(gvapython), gst_message_new_latency(GST_OBJECT(gvapython)));
+
     return set_python_callback_caps(gvapython->python_callback, incaps);
 }
 
+// Frames are held in batch mode, so latency reported upstream is increased by the longest time first frame of batch
+// waits for Python function call
+static gboolean gst_gva_python_query(GstBaseTransform *trans, GstPadDirection direction, GstQuery *query) {
+    GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
+    if (direction != GST_PAD_SRC || GST_QUERY_TYPE(query) != GST_QUERY_LATENCY)
+        return GST_BASE_TRANSFORM_CLASS(gst_gva_python_parent_class)->query(trans, direction, query);
+
+    if (!gst_pad_peer_query(GST_BASE_TRANSFORM_SINK_PAD(trans), query))
+        return FALSE;
+
+    gboolean live = FALSE;
+    GstClockTime min_latency = 0, max_latency = GST_CLOCK_TIME_NONE;
+    gst_query_parse_latency(query, &live, &min_latency, &max_latency);
+    GstClockTime hold_time = gst_gva_python_batch_hold_time(gvapython);
+    if (!GST_CLOCK_TIME_IS_VALID(hold_time)) {
+        GST_WARNING_OBJECT(gvapython, "Input framerate is unknown and batch-timeout is 0, latency of batching is not "
+                                      "reported. Set batch-timeout to bound it");
+        hold_time = 0;
+    }
+    min_latency += hold_time;
+    if (GST_CLOCK_TIME_IS_VALID(max_latency))
+        max_latency += hold_time;
+    GST_DEBUG_OBJECT(gvapython, "Batch hold time %" GST_TIME_FORMAT ", latency min %" GST_TIME_FORMAT
+                                ", max %" GST_TIME_FORMAT,
+                     GST_TIME_ARGS(hold_time), GST_TIME_ARGS(min_latency), GST_TIME_ARGS(max_latency));
+    gst_query_set_latency(query, live, min_latency, max_latency);
+    return TRUE;
+}
+
 void gst_gva_python_dispose(GObject *object) {
     GstGvaPython *gvapython = GST_GVA_PYTHON(object);
 
@@ -251,6 +386,11 @@ void gst_gva_python_finalize(GObject *object) {
         delete_arguments(gvapython->kwargs);
         gvapython->kwargs = NULL;
     }
+    if (gvapython->batch) {
+        gst_gva_python_clear_batch(gvapython);
+        g_ptr_array_free(gvapython->batch, TRUE);
+        gvapython->batch = NULL;
+    }
     G_OBJECT_CLASS(gst_gva_python_parent_class)->finalize(object);
 }
 
@@ -258,7 +398,93 @@ static GstFlowReturn gst_gva_python_transform_ip(GstBaseTransform *trans, GstBuf
     GstGvaPython *gvapython = GST_GVA_PYTHON(trans);
     GST_DEBUG_OBJECT(gvapython, "transform_ip");
 
-    return invoke_python_callback(gvapython->python_callback, buf);
+    if (gvapython->batch_size <= 1 && gvapython->batch->len == 0)
+        return invoke_python_callback(gvapython->python_callback, buf);
+
+    if (gvapython->batch->len == 0)
+        gvapython->batch_start = g_get_monotonic_time();
+    g_ptr_array_add(gvapython->batch, gst_buffer_ref(buf));
+
+    gboolean timed_out = gvapython->batch_timeout > 0 &&
+                         g_get_monotonic_time() - gvapython->batch_start >= (gint64)gvapython->batch_timeout * 1000;
+    if (gvapython->batch->len < gvapython->batch_size && !timed_out) {
+        // buffer is pushed downstream from transform_ip of one of next frames or on serialized event
+        return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    }
+    return gst_gva_python_process_batch(gvapython, buf);
+}
+
+/* Calls Python function for queued frames and pushes kept frames downstream. If current buffer of transform_ip is
+ * passed, it is the last queued frame and it's left for base class to push or drop according to returned status */
+static GstFlowReturn gst_gva_python_process_batch(GstGvaPython *gvapython, GstBuffer *current) {
+    GPtrArray *batch = gvapython->batch;
+    GstFlowReturn ret = GST_FLOW_OK;
+    gboolean keep_current = TRUE;
+    gboolean *keep = g_newa(gboolean, batch->len);
+
+    // base class holds reference to current buffer until transform_ip returns, so extra one is released to keep
+    // buffer writable for Python function
+    if (current)
+        gst_buffer_unref(current);
+
+    if (!invoke_python_callback_batch(gvapython->python_callback, (GstBuffer **)batch->pdata, batch->len, keep)) {
+        GST_ELEMENT_ERROR(gvapython, STREAM, FAILED, ("Error calling Python function"),
+                          ("Module: %s\n Function: %s\n Batch size: %u", gvapython->module_name,
+                           gvapython->function_name, batch->len));
+        if (current)
+            g_ptr_array_set_size(batch, batch->len - 1);
+        gst_gva_python_clear_batch(gvapython);
+        return GST_FLOW_ERROR;
+    }
+
+    for (guint i = 0; i < batch->len; i++) {
+        GstBuffer *buffer = (GstBuffer *)g_ptr_array_index(batch, i);
+        if (buffer == current) {
+            keep_current = keep[i];
+        } else if (!keep[i]) {
+            gst_buffer_unref(buffer);
+        } else if (ret == GST_FLOW_OK) {
+            ret = gst_pad_push(GST_BASE_TRANSFORM_SRC_PAD(gvapython), buffer);
+        } else {
+            // downstream refused previous frame, remaining ones are dropped
+            gst_buffer_unref(buffer);
+        }
+    }
+    g_ptr_array_set_size(batch, 0);
+
+    if (ret != GST_FLOW_OK || !current)
+        return ret;
+    return keep_current ? GST_FLOW_OK : GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+// First frame of batch waits for batch-size - 1 frames, or for batch-timeout which is checked on arrival of next frame.
+// GST_CLOCK_TIME_NONE if wait is unbounded as far as element knows
+static GstClockTime gst_gva_python_batch_hold_time(GstGvaPython *gvapython) {
+    GST_OBJECT_LOCK(gvapython);
+    const guint batch_size = gvapython->batch_size;
+    const guint batch_timeout = gvapython->batch_timeout;
+    const GstClockTime frame_duration = gvapython->frame_duration;
+    GST_OBJECT_UNLOCK(gvapython);
+
+    if (batch_size <= 1)
+        return 0;
+    GstClockTime hold_time = GST_CLOCK_TIME_NONE;
+    if (GST_CLOCK_TIME_IS_VALID(frame_duration))
+        hold_time = (batch_size - 1) * frame_duration;
+    if (batch_timeout > 0) {
+        GstClockTime timeout_hold_time = batch_timeout * GST_MSECOND;
+        if (GST_CLOCK_TIME_IS_VALID(frame_duration))
+            timeout_hold_time += frame_duration;
+        if (!GST_CLOCK_TIME_IS_VALID(hold_time) || timeout_hold_time < hold_time)
+            hold_time = timeout_hold_time;
+    }
+    return hold_time;
+}
+
+static void gst_gva_python_clear_batch(GstGvaPython *gvapython) {
+    for (guint i = 0; i < gvapython->batch->len; i++)
+        gst_buffer_unref((GstBuffer *)g_ptr_array_index(gvapython->batch, i));
+    g_ptr_array_set_size(gvapython->batch, 0);
 }
 
 static gboolean plugin_init(GstPlugin *plugin) {
@@ -31,6 +31,11 @@ struct _GstGvaPython {
     void *kwargs;
     void *args;
     struct PythonCallback *python_callback;
+    guint batch_size;
+    guint batch_timeout;
+    GPtrArray *batch;            // frames waiting for Python function call in batch mode
+    gint64 batch_start;          // monotonic time of first frame in batch, microseconds
+    GstClockTime frame_duration; // from framerate of input caps, GST_CLOCK_TIME_NONE if unknown
 };
 
 struct _GstGvaPythonClass {
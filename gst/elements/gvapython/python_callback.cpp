@@ -136,6 +136,51 @@ gboolean callPython(GstBuffer *buffer, PyObjectWrapper &py_videoframe_class, PyO
     return PyObject_IsTrue(result);
 }
 
+void callPythonBatch(GstBuffer **buffers, size_t count, gboolean *keep, PyObjectWrapper &py_videoframe_class,
+                     PyObjectWrapper &py_caps, PyObjectWrapper &py_function) {
+    // boxed buffers are referenced separately from frames list, as function is free to modify the list
+    DECL_WRAPPER(py_buffers, PyList_New(count));
+    DECL_WRAPPER(frames, PyList_New(count));
+    for (size_t i = 0; i < count; i++) {
+        PyObject *py_buffer = pyg_boxed_new(buffers[i]->mini_object.type, buffers[i], TRUE, TRUE);
+        if (!py_buffer)
+            throw std::runtime_error("Could not wrap Gst.Buffer");
+        PyList_SET_ITEM((PyObject *)py_buffers, i, py_buffer); // steals reference
+        PyObject *frame =
+            PyObject_CallFunctionObjArgs(py_videoframe_class, py_buffer, Py_None, (PyObject *)py_caps, nullptr);
+        if (!frame)
+            throw std::runtime_error("Could not create gstgva.VideoFrame");
+        PyList_SET_ITEM((PyObject *)frames, i, frame); // steals reference
+    }
+    DECL_WRAPPER(args, Py_BuildValue("(O)", (PyObject *)frames));
+
+    // make buffers writable, see callPython()
+    for (size_t i = 0; i < count; i++)
+        gst_buffer_unref(buffers[i]);
+
+    PyObjectWrapper result(PyObject_CallObject(py_function, args));
+
+    for (size_t i = 0; i < count; i++)
+        gst_buffer_ref(buffers[i]);
+    if (((PyObject *)result) == nullptr) {
+        throw std::runtime_error("Could not call py function");
+    }
+
+    // function returns either one value for the whole batch or sequence of values, one per frame
+    if (PyList_Check(result) || PyTuple_Check(result)) {
+        const Py_ssize_t size = PySequence_Size(result);
+        if (size != static_cast<Py_ssize_t>(count))
+            throw std::runtime_error("Python function returned " + std::to_string(size) + " values for " +
+                                     std::to_string(count) + " frames");
+        for (size_t i = 0; i < count; i++)
+            keep[i] = PyObject_IsTrue(PySequence_Fast_GET_ITEM((PyObject *)result, i)) == 1;
+    } else {
+        const gboolean keep_all = PyObject_IsTrue(result) == 1;
+        for (size_t i = 0; i < count; i++)
+            keep[i] = keep_all;
+    }
+}
+
 } // namespace
 
 PythonCallback::PythonCallback(const char *module_path, const char *class_name, const char *function_name,
@@ -207,7 +252,7 @@ PythonCallback::~PythonCallback() {
 }
 
 gboolean PythonCallback::CallPython(GstBuffer *buffer) {
-    ITT_TASK(module_name.c_str());
+    ITT_TASK(module_name);
 
     PyGILState_STATE state = PyGILState_Ensure();
 
@@ -217,3 +262,18 @@ gboolean PythonCallback::CallPython(GstBuffer *buffer) {
 
     return result;
 }
+
+void PythonCallback::CallPythonBatch(GstBuffer **buffers, size_t count, gboolean *keep) {
+    ITT_TASK(module_name);
+
+    PyGILState_STATE state = PyGILState_Ensure();
+    try {
+        callPythonBatch(buffers, count, keep, py_videoframe_class, py_caps, py_function);
+    } catch (...) {
+        // Python error indicator belongs to thread state, so it is logged while GIL is still held
+        log_python_error();
+        PyGILState_Release(state);
+        throw;
+    }
+    PyGILState_Release(state);
+}
@@ -26,4 +26,6 @@ class PythonCallback {
     ~PythonCallback();
 
     gboolean CallPython(GstBuffer *buf);
+    // Calls function once with list of frames. keep receives per-frame result of the call
+    void CallPythonBatch(GstBuffer **buffers, size_t count, gboolean *keep);
 };
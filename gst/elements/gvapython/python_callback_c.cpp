@@ -168,6 +168,21 @@ GstFlowReturn invoke_python_callback(struct PythonCallback *python_callback, Gst
     }
 }
 
+gboolean invoke_python_callback_batch(struct PythonCallback *python_callback, GstBuffer **buffers, guint count,
+                                      gboolean *keep) {
+    if (python_callback == nullptr) {
+        GST_ERROR("python_callback is not initialized");
+        return FALSE;
+    }
+    try {
+        python_callback->CallPythonBatch(buffers, count, keep);
+        return TRUE;
+    } catch (const std::exception &e) {
+        GST_ERROR("%s", Utils::createNestedErrorMsg(e).c_str());
+        return FALSE;
+    }
+}
+
 void delete_python_callback(struct PythonCallback *python_callback) {
     try {
         delete python_callback;
@@ -17,6 +17,9 @@ gboolean set_python_callback_caps(struct PythonCallback *python_callback, GstCap
 PythonCallback *create_python_callback(const char *module_path, const char *class_name, const char *function_name,
                                        const char *args_string, const char *kwargs_string);
 GstFlowReturn invoke_python_callback(struct PythonCallback *python_callback, GstBuffer *buffer);
+// Passes buffers to Python function as one list. Sets keep[i] to FALSE for frames to be dropped
+gboolean invoke_python_callback_batch(struct PythonCallback *python_callback, GstBuffer **buffers, guint count,
+                                      gboolean *keep);
 void delete_python_callback(struct PythonCallback *python_callback);
 void log_python_error();
 
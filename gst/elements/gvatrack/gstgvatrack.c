@@ -16,10 +16,16 @@ GST_DEBUG_CATEGORY_STATIC(gst_gva_track_debug_category);
 #define GST_CAT_DEFAULT gst_gva_track_debug_category
 
 #define DEFAULT_TRACKING_TYPE SHORT_TERM
+#define DEFAULT_TRACKING_SERVICE FALSE
+
+// Frames of one element in tracking service and in push queue, streaming thread blocks when limit is reached, so
+// slow downstream holds back upstream as with synchronous tracking
+#define MAX_IN_FLIGHT_FRAMES 4
 
 enum {
     PROP_0,
     PROP_TRACKING_TYPE,
+    PROP_TRACKING_SERVICE,
 };
 
 /// the capabilities of the inputs and outputs.
@@ -44,6 +50,14 @@ static GstFlowReturn gst_gva_track_transform_ip(GstBaseTransform *trans, GstBuff
 
 static GstStateChangeReturn gst_gva_track_change_state(GstElement *element, GstStateChange transition);
 
+static void gst_gva_track_release_tracker(GstGvaTrack *gva_track);
+static void gst_gva_track_on_tracked_buffer(GstBuffer *buffer, const gchar *error_message, gpointer user_data);
+static void gst_gva_track_push_loop(gpointer user_data);
+static void gst_gva_track_set_flushing(GstGvaTrack *gva_track, gboolean flushing);
+static GstFlowReturn gst_gva_track_take_last_flow(GstGvaTrack *gva_track);
+static GstFlowReturn gst_gva_track_wait_pushed(GstGvaTrack *gva_track);
+static void gst_gva_track_release_slot(GstGvaTrack *gva_track);
+
 static void gst_gva_track_class_init(GstGvaTrackClass *klass) {
     GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
 
@@ -78,11 +92,28 @@ static void gst_gva_track_class_init(GstGvaTrackClass *klass) {
                           "Tracking algorithm used to identify the same object in multiple frames. "
                           "Please see user guide for more details",
                           GST_GVA_TRACKING_TYPE, DEFAULT_TRACKING_TYPE, kDefaultGParamFlags));
+    g_object_class_install_property(
+        gobject_class, PROP_TRACKING_SERVICE,
+        g_param_spec_boolean("tracking-service", "Tracking Service",
+                             "Track on worker pool shared by all gvatrack elements of the process which have this "
+                             "property set, instead of the streaming thread. Frames of each element keep their order "
+                             "and are pushed downstream by the element's own source pad task, so a blocked downstream "
+                             "element stalls only its stream",
+                             DEFAULT_TRACKING_SERVICE, kDefaultGParamFlags));
 }
 
 static void gst_gva_track_init(GstGvaTrack *gva_track) {
     gva_track->tracking_type = DEFAULT_TRACKING_TYPE;
+    gva_track->tracking_service = DEFAULT_TRACKING_SERVICE;
     gva_track->tracker = NULL;
+    gva_track->stream_id = -1;
+    g_mutex_init(&gva_track->push_lock);
+    g_cond_init(&gva_track->push_cond);
+    g_queue_init(&gva_track->tracked_buffers);
+    gva_track->pushing = FALSE;
+    gva_track->push_flushing = FALSE;
+    gva_track->last_flow = GST_FLOW_OK;
+    gva_track->in_flight = 0;
 }
 
 static void gst_gva_track_set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec) {
@@ -93,6 +124,9 @@ static void gst_gva_track_set_property(GObject *object, guint prop_id, const GVa
     case PROP_TRACKING_TYPE:
         gva_track->tracking_type = g_value_get_enum(value);
         break;
+    case PROP_TRACKING_SERVICE:
+        gva_track->tracking_service = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -106,6 +140,9 @@ static void gst_gva_track_get_property(GObject *object, guint prop_id, GValue *v
     case PROP_TRACKING_TYPE:
         g_value_set_enum(value, gva_track->tracking_type);
         break;
+    case PROP_TRACKING_SERVICE:
+        g_value_set_boolean(value, gva_track->tracking_service);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -124,8 +161,10 @@ void gst_gva_track_dispose(GObject *object) {
 
 void gst_gva_track_finalize(GObject *object) {
     GstGvaTrack *gva_track = GST_GVA_TRACK(object);
-    release_tracker_instance(gva_track->tracker);
-    gva_track->tracker = NULL;
+    gst_gva_track_release_tracker(gva_track);
+    g_queue_clear_full(&gva_track->tracked_buffers, (GDestroyNotify)gst_buffer_unref);
+    g_mutex_clear(&gva_track->push_lock);
+    g_cond_clear(&gva_track->push_cond);
 
     G_OBJECT_CLASS(gst_gva_track_parent_class)->finalize(object);
 }
@@ -133,6 +172,19 @@ void gst_gva_track_finalize(GObject *object) {
 static GstStateChangeReturn gst_gva_track_change_state(GstElement *element, GstStateChange transition) {
     GstGvaTrack *gva_track = GST_GVA_TRACK(element);
 
+    switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+        gst_gva_track_set_flushing(gva_track, FALSE);
+        break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+        // downstream elements are already in READY, so push in progress returns and the task can be joined
+        gst_gva_track_set_flushing(gva_track, TRUE);
+        gst_pad_stop_task(GST_BASE_TRANSFORM_SRC_PAD(gva_track));
+        break;
+    default:
+        break;
+    }
+
     GstStateChangeReturn ret = GST_ELEMENT_CLASS(gst_gva_track_parent_class)->change_state(element, transition);
     GST_DEBUG_OBJECT(gva_track, "GstStateChangeReturn: %s", gst_element_state_change_return_get_name(ret));
 
@@ -149,13 +201,16 @@ static gboolean gst_gva_track_set_caps(GstBaseTransform *trans, GstCaps *incaps,
         gva_track->info = gst_video_info_new();
     }
     gst_video_info_from_caps(gva_track->info, incaps);
-    if (gva_track->tracker != NULL) {
-        release_tracker_instance(gva_track->tracker);
-        gva_track->tracker = NULL;
-    }
+    gst_gva_track_release_tracker(gva_track);
     if (gva_track->tracker == NULL) {
         GError *error = NULL;
         gva_track->tracker = acquire_tracker_instance(gva_track->info, gva_track->tracking_type, &error);
+        if (!error && gva_track->tracking_service) {
+            gva_track->stream_id =
+                tracking_service_add_stream(gva_track->tracker, gst_gva_track_on_tracked_buffer, gva_track, &error);
+            if (error)
+                gva_track->tracker = NULL; // released by tracking service
+        }
         if (error) {
             GST_ELEMENT_ERROR(gva_track, LIBRARY, INIT, ("tracker intitialization failed"), ("%s", error->message));
             g_error_free(error);
@@ -171,6 +226,37 @@ static gboolean gst_gva_track_sink_event(GstBaseTransform *trans, GstEvent *even
 
     GST_DEBUG_OBJECT(gva_track, "sink_event %s", GST_EVENT_TYPE_NAME(event));
 
+    if (gva_track->stream_id < 0)
+        return GST_BASE_TRANSFORM_CLASS(gst_gva_track_parent_class)->sink_event(trans, event);
+
+    switch (GST_EVENT_TYPE(event)) {
+    case GST_EVENT_FLUSH_START: {
+        gst_gva_track_set_flushing(gva_track, TRUE);
+        // flush goes downstream first to unblock push in progress, then the task can be paused
+        gboolean ret = GST_BASE_TRANSFORM_CLASS(gst_gva_track_parent_class)->sink_event(trans, event);
+        gst_pad_pause_task(GST_BASE_TRANSFORM_SRC_PAD(trans));
+        return ret;
+    }
+    case GST_EVENT_FLUSH_STOP:
+        // frames tracked before the flush are dropped
+        tracking_service_drain(gva_track->stream_id);
+        gst_gva_track_set_flushing(gva_track, FALSE);
+        break;
+    default:
+        if (GST_EVENT_IS_SERIALIZED(event)) {
+            // frames queued to tracking service must go downstream before serialized events (EOS, segment, caps, ...)
+            tracking_service_drain(gva_track->stream_id);
+            GstFlowReturn flow = gst_gva_track_wait_pushed(gva_track);
+            if (flow == GST_FLOW_FLUSHING || flow < GST_FLOW_EOS) {
+                GST_DEBUG_OBJECT(gva_track, "dropping event %s, last push returned %s", GST_EVENT_TYPE_NAME(event),
+                                 gst_flow_get_name(flow));
+                gst_event_unref(event);
+                return FALSE;
+            }
+        }
+        break;
+    }
+
     return GST_BASE_TRANSFORM_CLASS(gst_gva_track_parent_class)->sink_event(trans, event);
 }
 
@@ -180,7 +266,9 @@ static gboolean gst_gva_track_start(GstBaseTransform *trans) {
 }
 
 static gboolean gst_gva_track_stop(GstBaseTransform *trans) {
-    UNUSED(trans);
+    GstGvaTrack *gva_track = GST_GVA_TRACK(trans);
+    if (gva_track->stream_id >= 0)
+        tracking_service_drain(gva_track->stream_id);
     return TRUE;
 }
 
@@ -188,7 +276,37 @@ static GstFlowReturn gst_gva_track_transform_ip(GstBaseTransform *trans, GstBuff
     GError *error = NULL;
     GstGvaTrack *gva_track = GST_GVA_TRACK(trans);
     GstFlowReturn status = GST_FLOW_OK;
-    if (gva_track && gva_track->tracker) {
+    if (gva_track && gva_track->stream_id >= 0) {
+        // flow of buffers pushed since the previous call is reported upstream instead of processing this one
+        status = gst_gva_track_take_last_flow(gva_track);
+        if (status != GST_FLOW_OK)
+            return status;
+        GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD(trans);
+        if (gst_pad_get_task_state(srcpad) != GST_TASK_STARTED &&
+            !gst_pad_start_task(srcpad, gst_gva_track_push_loop, gva_track, NULL)) {
+            GST_ELEMENT_ERROR(gva_track, STREAM, FAILED, ("transform_ip failed"), ("%s", "failed to start push task"));
+            return GST_FLOW_ERROR;
+        }
+        // wait for a free slot, unblocked by push of tracked frame or by flush
+        g_mutex_lock(&gva_track->push_lock);
+        while (gva_track->in_flight >= MAX_IN_FLIGHT_FRAMES && !gva_track->push_flushing)
+            g_cond_wait(&gva_track->push_cond, &gva_track->push_lock);
+        if (gva_track->push_flushing) {
+            g_mutex_unlock(&gva_track->push_lock);
+            return GST_FLOW_FLUSHING;
+        }
+        gva_track->in_flight++;
+        g_mutex_unlock(&gva_track->push_lock);
+        // buffer is pushed from source pad task once tracked
+        tracking_service_submit(gva_track->stream_id, gst_buffer_ref(buf), &error);
+        if (error) {
+            gst_gva_track_release_slot(gva_track);
+            GST_ELEMENT_ERROR(gva_track, STREAM, FAILED, ("transform_ip failed"), ("%s", error->message));
+            g_error_free(error);
+            return GST_FLOW_ERROR;
+        }
+        status = GST_BASE_TRANSFORM_FLOW_DROPPED;
+    } else if (gva_track && gva_track->tracker) {
         transform_tracked_objects(gva_track->tracker, buf, &error);
         if (error) {
             GST_ELEMENT_ERROR(gva_track, STREAM, FAILED, ("transform_ip failed"), ("%s", error->message));
@@ -201,3 +319,110 @@ static GstFlowReturn gst_gva_track_transform_ip(GstBaseTransform *trans, GstBuff
     }
     return status;
 }
+
+static void gst_gva_track_release_tracker(GstGvaTrack *gva_track) {
+    if (gva_track->stream_id >= 0) {
+        // tracking service owns the tracker
+        tracking_service_remove_stream(gva_track->stream_id);
+        gva_track->stream_id = -1;
+    } else {
+        release_tracker_instance(gva_track->tracker);
+    }
+    gva_track->tracker = NULL;
+}
+
+// Called on tracking service thread, must not block
+static void gst_gva_track_on_tracked_buffer(GstBuffer *buffer, const gchar *error_message, gpointer user_data) {
+    GstGvaTrack *gva_track = GST_GVA_TRACK(user_data);
+    if (error_message && error_message[0]) {
+        GST_ELEMENT_ERROR(gva_track, STREAM, FAILED, ("transform_ip failed"), ("%s", error_message));
+        gst_buffer_unref(buffer);
+        g_mutex_lock(&gva_track->push_lock);
+        if (gva_track->last_flow == GST_FLOW_OK)
+            gva_track->last_flow = GST_FLOW_ERROR;
+        gva_track->in_flight--;
+        g_cond_broadcast(&gva_track->push_cond);
+        g_mutex_unlock(&gva_track->push_lock);
+        return;
+    }
+    g_mutex_lock(&gva_track->push_lock);
+    if (gva_track->push_flushing) {
+        gst_buffer_unref(buffer);
+        gva_track->in_flight--;
+        g_cond_broadcast(&gva_track->push_cond);
+    } else {
+        g_queue_push_tail(&gva_track->tracked_buffers, buffer);
+        g_cond_broadcast(&gva_track->push_cond);
+    }
+    g_mutex_unlock(&gva_track->push_lock);
+}
+
+static void gst_gva_track_push_loop(gpointer user_data) {
+    GstGvaTrack *gva_track = GST_GVA_TRACK(user_data);
+    GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD(gva_track);
+
+    g_mutex_lock(&gva_track->push_lock);
+    while (g_queue_is_empty(&gva_track->tracked_buffers) && !gva_track->push_flushing)
+        g_cond_wait(&gva_track->push_cond, &gva_track->push_lock);
+    if (gva_track->push_flushing) {
+        g_mutex_unlock(&gva_track->push_lock);
+        gst_pad_pause_task(srcpad);
+        return;
+    }
+    GstBuffer *buffer = GST_BUFFER(g_queue_pop_head(&gva_track->tracked_buffers));
+    gva_track->pushing = TRUE;
+    g_mutex_unlock(&gva_track->push_lock);
+
+    GstFlowReturn ret = gst_pad_push(srcpad, buffer);
+    if (ret != GST_FLOW_OK)
+        GST_DEBUG_OBJECT(gva_track, "gst_pad_push returned status %s", gst_flow_get_name(ret));
+
+    g_mutex_lock(&gva_track->push_lock);
+    gva_track->pushing = FALSE;
+    gva_track->in_flight--;
+    // first failure is kept until it is reported upstream
+    if (gva_track->last_flow == GST_FLOW_OK)
+        gva_track->last_flow = ret;
+    g_cond_broadcast(&gva_track->push_cond);
+    g_mutex_unlock(&gva_track->push_lock);
+}
+
+static void gst_gva_track_set_flushing(GstGvaTrack *gva_track, gboolean flushing) {
+    g_mutex_lock(&gva_track->push_lock);
+    gva_track->push_flushing = flushing;
+    gva_track->last_flow = flushing ? GST_FLOW_FLUSHING : GST_FLOW_OK;
+    if (flushing) {
+        // frames still tracked by the service release their slots when they come back
+        gva_track->in_flight -= g_queue_get_length(&gva_track->tracked_buffers);
+        g_queue_clear_full(&gva_track->tracked_buffers, (GDestroyNotify)gst_buffer_unref);
+    }
+    g_cond_broadcast(&gva_track->push_cond);
+    g_mutex_unlock(&gva_track->push_lock);
+}
+
+// Flushing is kept until flush stop, other results are reported once
+static GstFlowReturn gst_gva_track_take_last_flow(GstGvaTrack *gva_track) {
+    g_mutex_lock(&gva_track->push_lock);
+    GstFlowReturn flow = gva_track->last_flow;
+    if (flow != GST_FLOW_FLUSHING)
+        gva_track->last_flow = GST_FLOW_OK;
+    g_mutex_unlock(&gva_track->push_lock);
+    return flow;
+}
+
+// Waits until all tracked buffers are pushed, returns result of the last push
+static GstFlowReturn gst_gva_track_wait_pushed(GstGvaTrack *gva_track) {
+    g_mutex_lock(&gva_track->push_lock);
+    while (!gva_track->push_flushing && (gva_track->pushing || !g_queue_is_empty(&gva_track->tracked_buffers)))
+        g_cond_wait(&gva_track->push_cond, &gva_track->push_lock);
+    GstFlowReturn flow = gva_track->last_flow;
+    g_mutex_unlock(&gva_track->push_lock);
+    return flow;
+}
+
+static void gst_gva_track_release_slot(GstGvaTrack *gva_track) {
+    g_mutex_lock(&gva_track->push_lock);
+    gva_track->in_flight--;
+    g_cond_broadcast(&gva_track->push_cond);
+    g_mutex_unlock(&gva_track->push_lock);
+}
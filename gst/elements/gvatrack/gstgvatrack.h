@@ -24,8 +24,20 @@ typedef struct _GstGvaTrack {
     GstVideoInfo *info;
 
     GstGvaTrackingType tracking_type;
+    gboolean tracking_service;
 
     ITracker *tracker;
+    gint stream_id; // stream of shared tracking service which owns the tracker, -1 if not used
+
+    // Buffers tracked by the service are pushed downstream by the task of source pad, so service threads never
+    // block on downstream elements. Guarded by push_lock
+    GMutex push_lock;
+    GCond push_cond;
+    GQueue tracked_buffers;
+    gboolean pushing;        // buffer taken from the queue is being pushed
+    gboolean push_flushing;  // task is stopped or paused, queued buffers are dropped
+    GstFlowReturn last_flow; // result of the last push, returned upstream from next transform_ip
+    guint in_flight;         // frames submitted to tracking service and not pushed or dropped yet
 } GstGvaTrack;
 
 typedef struct _GstGvaTrackClass {
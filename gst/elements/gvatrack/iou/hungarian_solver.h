@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace iou {
+
+///
+/// \brief The HungarianSolver class
+///
+/// Solves the rectangular assignment problem with shortest augmenting paths
+/// (Jonker-Volgenant variant of the Hungarian algorithm) in O(n^2 * m) time,
+/// where n and m are the smaller and the larger dimension of the cost matrix.
+/// Matrix is not padded to square. Workspace is kept between calls, so
+/// solving problems of the same or smaller size does not allocate memory.
+/// \tparam Cost Cost type, e.g. float or int16_t. Dual variables are kept in
+/// double for floating point costs and in int64_t for integer costs.
+///
+template <typename Cost>
+class HungarianSolver {
+  public:
+    static constexpr size_t kNoAssignment = static_cast<size_t>(-1);
+
+    ///
+    /// \brief Finds assignment of rows to columns with minimal total cost.
+    /// \param costs Row-major rows x cols cost matrix.
+    /// \param rows Number of rows.
+    /// \param cols Number of columns.
+    /// \param row_to_col Column assigned to each row, kNoAssignment for rows
+    /// left unassigned when there are more rows than columns.
+    ///
+    void Solve(const Cost *costs, size_t rows, size_t cols, std::vector<size_t> &row_to_col) {
+        row_to_col.assign(rows, kNoAssignment);
+        if (rows == 0 || cols == 0)
+            return;
+
+        // algorithm assigns each of n "rows" to one of m >= n "columns", so taller matrix is solved transposed
+        const bool transposed = rows > cols;
+        const size_t n = transposed ? cols : rows;
+        const size_t m = transposed ? rows : cols;
+        auto cost = [costs, cols, transposed](size_t i, size_t j) -> Value {
+            return transposed ? costs[j * cols + i] : costs[i * cols + j];
+        };
+
+        // 1-based indices, column 0 is a virtual column holding the row being added
+        u.assign(n + 1, 0);
+        v.assign(m + 1, 0);
+        owner.assign(m + 1, 0);
+        way.assign(m + 1, 0);
+        for (size_t i = 1; i <= n; i++) {
+            owner[0] = i;
+            size_t j0 = 0;
+            min_slack.assign(m + 1, kInfinity);
+            used.assign(m + 1, 0);
+            do {
+                used[j0] = 1;
+                const size_t i0 = owner[j0];
+                Value delta = kInfinity;
+                size_t j1 = 0;
+                for (size_t j = 1; j <= m; j++) {
+                    if (used[j])
+                        continue;
+                    const Value slack = cost(i0 - 1, j - 1) - u[i0] - v[j];
+                    if (slack < min_slack[j]) {
+                        min_slack[j] = slack;
+                        way[j] = j0;
+                    }
+                    if (min_slack[j] < delta) {
+                        delta = min_slack[j];
+                        j1 = j;
+                    }
+                }
+                for (size_t j = 0; j <= m; j++) {
+                    if (used[j]) {
+                        u[owner[j]] += delta;
+                        v[j] -= delta;
+                    } else {
+                        min_slack[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while (owner[j0] != 0);
+            // flip augmenting path
+            do {
+                const size_t j1 = way[j0];
+                owner[j0] = owner[j1];
+                j0 = j1;
+            } while (j0 != 0);
+        }
+
+        for (size_t j = 1; j <= m; j++) {
+            if (owner[j] == 0)
+                continue;
+            if (transposed)
+                row_to_col[j - 1] = owner[j] - 1;
+            else
+                row_to_col[owner[j] - 1] = j - 1;
+        }
+    }
+
+  private:
+    using Value = typename std::conditional<std::is_floating_point<Cost>::value, double, int64_t>::type;
+    static constexpr Value kInfinity = std::numeric_limits<Value>::max();
+
+    std::vector<Value> u;         ///< Row potentials.
+    std::vector<Value> v;         ///< Column potentials.
+    std::vector<size_t> owner;    ///< Row assigned to column, 0 if none.
+    std::vector<size_t> way;      ///< Previous column on shortest path.
+    std::vector<Value> min_slack; ///< Shortest path length to column.
+    std::vector<char> used;       ///< Column is in the shortest path tree.
+};
+
+template <typename Cost>
+constexpr size_t HungarianSolver<Cost>::kNoAssignment;
+
+template <typename Cost>
+constexpr typename HungarianSolver<Cost>::Value HungarianSolver<Cost>::kInfinity;
+
+} // namespace iou
@@ -15,7 +15,7 @@ namespace iou {
 ///
 /// \brief The KuhnMunkres class
 ///
-/// Solves the assignment problem.
+/// Solves the assignment problem. cv::Mat interface to HungarianSolver.
 ///
 class KuhnMunkres {
   public:
@@ -28,7 +28,8 @@ class KuhnMunkres {
     /// first row in the dissimilarity matrix).
     /// \param dissimilarity_matrix CV_32F dissimilarity matrix.
     /// \return Optimal column index for each row. -1 means that there is no
-    /// column for row.
+    /// column for row. Rectangular matrix is not padded, so if there are more
+    /// rows than columns, extra rows get -1.
     ///
     std::vector<size_t> Solve(const cv::Mat &dissimilarity_matrix);
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <opencv2/core/core.hpp>
 #include <vector>
 
@@ -30,17 +31,132 @@ struct TrackedObject {
 
 using TrackedObjects = std::vector<TrackedObject>;
 
+///
+/// \brief The TrackHistory class stores latest objects of a track in a ring
+/// buffer. Once capacity is reached, the oldest object is overwritten, so
+/// history of a long-lived track takes constant memory.
+///
+class TrackHistory {
+  public:
+    template <typename History, typename Object>
+    class Iterator {
+      public:
+        Iterator(History *history, size_t index) : history(history), index(index) {
+        }
+        Object &operator*() const {
+            return (*history)[index];
+        }
+        Iterator &operator++() {
+            ++index;
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const {
+            return index != other.index;
+        }
+
+      private:
+        History *history;
+        size_t index;
+    };
+    using iterator = Iterator<TrackHistory, TrackedObject>;
+    using const_iterator = Iterator<const TrackHistory, const TrackedObject>;
+
+    ///
+    /// \param capacity Max number of stored objects, 0 means not restricted.
+    ///
+    explicit TrackHistory(size_t capacity = 0) : capacity(capacity), start(0) {
+    }
+
+    bool empty() const {
+        return objects.empty();
+    }
+
+    size_t size() const {
+        return objects.size();
+    }
+
+    ///
+    /// \brief Clears history keeping allocated memory.
+    ///
+    void clear() {
+        objects.clear();
+        start = 0;
+    }
+
+    void push_back(const TrackedObject &object) {
+        if (capacity == 0 || objects.size() < capacity) {
+            objects.push_back(object);
+        } else {
+            objects[start] = object;
+            start = (start + 1) % objects.size();
+        }
+    }
+
+    ///
+    /// \brief Object with index 0 is the oldest one.
+    ///
+    const TrackedObject &operator[](size_t i) const {
+        return objects[(start + i) % objects.size()];
+    }
+
+    TrackedObject &operator[](size_t i) {
+        return objects[(start + i) % objects.size()];
+    }
+
+    const TrackedObject &back() const {
+        return (*this)[objects.size() - 1];
+    }
+
+    TrackedObject &back() {
+        return (*this)[objects.size() - 1];
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, objects.size());
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, objects.size());
+    }
+
+  private:
+    std::vector<TrackedObject> objects;
+    size_t capacity;
+    size_t start; ///< Position of the oldest object once buffer is full.
+};
+
 ///
 /// \brief The Track struct describes tracks.
 ///
 struct Track {
     ///
     /// \brief Track constructor.
-    /// \param objs Detected objects sequence.
+    /// \param id Track ID.
+    /// \param object First detected object.
+    /// \param max_history Max number of objects kept in track, 0 means not
+    /// restricted.
+    ///
+    Track(size_t id, const TrackedObject &object, size_t max_history) : objects(max_history) {
+        Reset(id, object);
+    }
+
+    ///
+    /// \brief Reinitializes track with new first object reusing memory of
+    /// object history.
     ///
-    explicit Track(const TrackedObjects &objs) : objects(objs), lost(0), length(1) {
-        CV_Assert(!objs.empty());
-        first_object = objs[0];
+    void Reset(size_t id, const TrackedObject &object) {
+        this->id = id;
+        objects.clear();
+        objects.push_back(object);
+        first_object = object;
+        lost = 0;
+        length = 1;
+        velocity = cv::Vec4f(0, 0, 0, 0);
     }
 
     ///
@@ -97,12 +213,14 @@ struct Track {
         return objects.back();
     }
 
-    TrackedObjects objects; ///< Detected objects;
-    size_t lost;            ///< How many frames ago track has been lost.
+    size_t id;            ///< Track ID, unique during tracker lifetime.
+    TrackHistory objects; ///< Latest detected objects.
+    size_t lost;          ///< How many frames ago track has been lost.
 
     TrackedObject first_object; ///< First object in track.
     size_t length;              ///< Length of a track including number of objects that were
                                 /// removed from track in order to avoid memory usage growth.
+    cv::Vec4f velocity;         ///< Smoothed change of x, y, width and height of bounding box per frame.
 };
 
 } // namespace iou
@@ -15,7 +15,10 @@
 #include "gva_tensor_meta.h"
 #include "gva_utils.h"
 #include "inference_backend/safe_arithmetic.h"
-#include "kuhn_munkres.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 using namespace iou;
 
@@ -33,12 +36,22 @@ cv::Point Center(const cv::Rect &rect) {
     return cv::Point(rect.x + rect.width * .5, rect.y + rect.height * .5);
 }
 
+// Weight of the latest displacement in smoothed track velocity
+const float kVelocityWeight = 0.5f;
+
+// Limit of gating grid cells per axis, cells grow if detections are small relatively to the frame
+const int kMaxGridSize = 64;
+
+// Number of frames between checks whether track storage should be shrunk
+const size_t kCompactionPeriod = 1000;
+
 } // namespace
 
 TrackerParams::TrackerParams()
     : min_track_duration(1), forget_delay(150), affinity_thr(0.8), shape_affinity_w(0.5), motion_affinity_w(0.2),
       min_det_conf(0.0), averaging_window_size(1), bbox_aspect_ratios_range(0.666, 5.0), bbox_heights_range(10, 1080),
-      drop_forgotten_tracks(false), max_num_objects_in_track(std::numeric_limits<int>::max()), objects_type("face") {
+      drop_forgotten_tracks(true), max_num_objects_in_track(32), objects_type("face"),
+      max_prediction_frames(30) {
 }
 
 Tracker::Tracker(const GstVideoInfo *video_info, const TrackerParams &params)
@@ -76,6 +89,8 @@ void Tracker::FilterDetectionsAndStore(GVA::VideoFrame &frame) {
                     break;
                 }
             }
+            if (tracked_obj.label != TrackedObject::UNKNOWN_LABEL_IDX && !labels_.count(tracked_obj.label))
+                labels_[tracked_obj.label] = roi.label();
 
             detections_.emplace_back(tracked_obj);
         }
@@ -83,7 +98,7 @@ void Tracker::FilterDetectionsAndStore(GVA::VideoFrame &frame) {
     }
 }
 
-void Tracker::SolveAssignmentProblem(const std::set<size_t> &track_ids, const TrackedObjects &detections,
+void Tracker::SolveAssignmentProblem(const std::vector<size_t> &track_slots, const TrackedObjects &detections,
                                      std::set<size_t> *unmatched_tracks, std::set<size_t> *unmatched_detections,
                                      std::set<std::tuple<size_t, size_t, float>> *matches) {
     CV_Assert(unmatched_tracks);
@@ -91,64 +106,213 @@ void Tracker::SolveAssignmentProblem(const std::set<size_t> &track_ids, const Tr
     unmatched_tracks->clear();
     unmatched_detections->clear();
 
-    CV_Assert(!track_ids.empty());
+    CV_Assert(!track_slots.empty());
     CV_Assert(!detections.empty());
     CV_Assert(matches);
     matches->clear();
 
-    cv::Mat dissimilarity;
-    ComputeDissimilarityMatrix(track_ids, detections, &dissimilarity);
-
-    std::vector<size_t> res = KuhnMunkres().Solve(dissimilarity);
+    // compare with position extrapolated to the current frame, detections may be several frames apart
+    std::vector<cv::Rect> predicted;
+    predicted.reserve(track_slots.size());
+    for (size_t slot : track_slots)
+        predicted.push_back(PredictedRect(slots_[slot].track, detections.front().frame_idx));
+
+    FindAssignmentCandidates(predicted, detections);
+
+    // Candidate pairs form a sparse bipartite graph, its connected components are independent assignment problems.
+    // Tracks are nodes [0, n), detections are nodes [n, n + m)
+    const size_t n = track_slots.size();
+    component_parent_.resize(n + detections.size());
+    std::iota(component_parent_.begin(), component_parent_.end(), 0);
+    auto find_root = [this](size_t node) {
+        while (component_parent_[node] != node)
+            node = component_parent_[node] = component_parent_[component_parent_[node]];
+        return node;
+    };
+    for (const AssignmentCandidate &candidate : candidates_) {
+        const size_t a = find_root(candidate.track);
+        const size_t b = find_root(n + candidate.detection);
+        if (a != b)
+            component_parent_[std::max(a, b)] = std::min(a, b);
+    }
+    component_index_.resize(n);
+    for (size_t i = 0; i < n; i++)
+        component_index_[i] = find_root(i);
+
+    std::sort(candidates_.begin(), candidates_.end(),
+              [this](const AssignmentCandidate &a, const AssignmentCandidate &b) {
+                  return component_index_[a.track] < component_index_[b.track];
+              });
+    for (auto begin = candidates_.cbegin(); begin != candidates_.cend();) {
+        const size_t component = component_index_[begin->track];
+        auto end = std::find_if(begin, candidates_.cend(), [this, component](const AssignmentCandidate &candidate) {
+            return component_index_[candidate.track] != component;
+        });
+        SolveComponent(begin, end, track_slots, matches);
+        begin = end;
+    }
 
     for (size_t i = 0; i < detections.size(); i++) {
         unmatched_detections->insert(i);
     }
 
-    size_t i = 0;
-    for (auto id : track_ids) {
-        if (res[i] < detections.size()) {
-            matches->emplace(id, res[i], 1 - dissimilarity.at<float>(i, res[i]));
-        } else {
-            unmatched_tracks->insert(id);
+    for (size_t slot : track_slots) {
+        auto match = matches->lower_bound(std::make_tuple(slot, size_t(0), -std::numeric_limits<float>::max()));
+        if (match == matches->cend() || std::get<0>(*match) != slot)
+            unmatched_tracks->insert(slot);
+    }
+}
+
+void Tracker::FindAssignmentCandidates(const std::vector<cv::Rect> &predicted, const TrackedObjects &detections) {
+    candidates_.clear();
+    if (params_.affinity_thr >= 1)
+        return;
+
+    auto add_if_acceptable = [&](size_t i, size_t j) {
+        const float dissimilarity = Distance(predicted[i], detections[j].rect);
+        if (1 - dissimilarity > params_.affinity_thr)
+            candidates_.push_back({i, j, dissimilarity});
+    };
+
+    // Affinity of a pair can't exceed its motion affinity, so pair is acceptable only if detection is closer to
+    // predicted position of the track than 'gate' detection sizes along both axes
+    if (params_.affinity_thr <= 0 || params_.motion_affinity_w <= 0) {
+        for (size_t i = 0; i < predicted.size(); i++)
+            for (size_t j = 0; j < detections.size(); j++)
+                add_if_acceptable(i, j);
+        return;
+    }
+    const float gate = std::sqrt(-std::log(params_.affinity_thr) / params_.motion_affinity_w);
+
+    // Detections are bucketed by top-left corner into cells not smaller than the gate of the largest detection, so
+    // every acceptable detection lies in 3x3 cells around the track
+    int min_x = detections.front().rect.x, max_x = min_x;
+    int min_y = detections.front().rect.y, max_y = min_y;
+    int max_width = 1, max_height = 1;
+    for (const TrackedObject &detection : detections) {
+        min_x = std::min(min_x, detection.rect.x);
+        max_x = std::max(max_x, detection.rect.x);
+        min_y = std::min(min_y, detection.rect.y);
+        max_y = std::max(max_y, detection.rect.y);
+        max_width = std::max(max_width, detection.rect.width);
+        max_height = std::max(max_height, detection.rect.height);
+    }
+    const float cell_width = std::max(max_width * gate + 1, static_cast<float>(max_x - min_x) / kMaxGridSize + 1);
+    const float cell_height = std::max(max_height * gate + 1, static_cast<float>(max_y - min_y) / kMaxGridSize + 1);
+    const int cols = static_cast<int>((max_x - min_x) / cell_width) + 1;
+    const int rows = static_cast<int>((max_y - min_y) / cell_height) + 1;
+    auto cell_of = [](float position, float cell_size, int cells) {
+        return static_cast<int>(std::min(std::max(std::floor(position / cell_size), -2.f), cells + 1.f));
+    };
+
+    grid_cell_begin_.assign(cols * rows + 1, 0);
+    grid_items_.resize(detections.size());
+    for (const TrackedObject &detection : detections) {
+        const int cell = cell_of(detection.rect.y - min_y, cell_height, rows) * cols +
+                         cell_of(detection.rect.x - min_x, cell_width, cols);
+        grid_cell_begin_[cell + 1]++;
+    }
+    std::partial_sum(grid_cell_begin_.begin(), grid_cell_begin_.end(), grid_cell_begin_.begin());
+    grid_fill_.assign(grid_cell_begin_.begin(), grid_cell_begin_.end() - 1);
+    for (size_t j = 0; j < detections.size(); j++) {
+        const int cell = cell_of(detections[j].rect.y - min_y, cell_height, rows) * cols +
+                         cell_of(detections[j].rect.x - min_x, cell_width, cols);
+        grid_items_[grid_fill_[cell]++] = j;
+    }
+
+    for (size_t i = 0; i < predicted.size(); i++) {
+        const cv::Rect &track = predicted[i];
+        const int col = cell_of(track.x - min_x, cell_width, cols);
+        const int row = cell_of(track.y - min_y, cell_height, rows);
+        for (int r = std::max(row - 1, 0); r <= std::min(row + 1, rows - 1); r++) {
+            for (int c = std::max(col - 1, 0); c <= std::min(col + 1, cols - 1); c++) {
+                const int cell = r * cols + c;
+                for (size_t k = grid_cell_begin_[cell]; k < grid_cell_begin_[cell + 1]; k++) {
+                    const cv::Rect &detection = detections[grid_items_[k]].rect;
+                    if (std::abs(track.x - detection.x) <= detection.width * gate &&
+                        std::abs(track.y - detection.y) <= detection.height * gate)
+                        add_if_acceptable(i, grid_items_[k]);
+                }
+            }
         }
-        i++;
     }
 }
 
-bool Tracker::EraseTrackIfBBoxIsOutOfFrame(size_t track_id) {
-    if (tracks_.find(track_id) == tracks_.end())
+void Tracker::SolveComponent(std::vector<AssignmentCandidate>::const_iterator begin,
+                             std::vector<AssignmentCandidate>::const_iterator end,
+                             const std::vector<size_t> &track_slots,
+                             std::set<std::tuple<size_t, size_t, float>> *matches) {
+    std::vector<size_t> tracks, detections;
+    for (auto it = begin; it != end; ++it) {
+        tracks.push_back(it->track);
+        detections.push_back(it->detection);
+    }
+    std::sort(tracks.begin(), tracks.end());
+    tracks.erase(std::unique(tracks.begin(), tracks.end()), tracks.end());
+    std::sort(detections.begin(), detections.end());
+    detections.erase(std::unique(detections.begin(), detections.end()), detections.end());
+
+    // with single track or single detection the best pair is the optimal assignment
+    if (tracks.size() == 1 || detections.size() == 1) {
+        auto best = std::min_element(begin, end, [](const AssignmentCandidate &a, const AssignmentCandidate &b) {
+            return a.dissimilarity < b.dissimilarity;
+        });
+        matches->emplace(track_slots[best->track], best->detection, 1 - best->dissimilarity);
+        return;
+    }
+
+    // pairs rejected by gating get the largest dissimilarity, assignment to them is treated as no match
+    const size_t cols = detections.size();
+    component_costs_.assign(tracks.size() * cols, 1.f);
+    for (auto it = begin; it != end; ++it) {
+        const size_t row = std::lower_bound(tracks.begin(), tracks.end(), it->track) - tracks.begin();
+        const size_t col = std::lower_bound(detections.begin(), detections.end(), it->detection) - detections.begin();
+        component_costs_[row * cols + col] = it->dissimilarity;
+    }
+
+    assignment_solver_.Solve(component_costs_.data(), tracks.size(), cols, component_assignment_);
+    for (size_t row = 0; row < tracks.size(); row++) {
+        const size_t col = component_assignment_[row];
+        if (col < cols && component_costs_[row * cols + col] < 1)
+            matches->emplace(track_slots[tracks[row]], detections[col], 1 - component_costs_[row * cols + col]);
+    }
+}
+
+bool Tracker::EraseTrackIfBBoxIsOutOfFrame(size_t slot) {
+    TrackSlot &track_slot = slots_[slot];
+    if (!track_slot.active)
         return true;
-    auto c = Center(tracks_.at(track_id).back().rect);
+    auto c = Center(track_slot.track.back().rect);
     if (frame_size_ != cv::Size() && (c.x < 0 || c.y < 0 || c.x > frame_size_.width || c.y > frame_size_.height)) {
-        tracks_.at(track_id).lost = params_.forget_delay + 1;
-        active_track_ids_.erase(track_id);
+        track_slot.track.lost = params_.forget_delay + 1;
+        track_slot.active = false;
         return true;
     }
     return false;
 }
 
-bool Tracker::EraseTrackIfItWasLostTooManyFramesAgo(size_t track_id) {
-    if (tracks_.find(track_id) == tracks_.end())
+bool Tracker::EraseTrackIfItWasLostTooManyFramesAgo(size_t slot) {
+    TrackSlot &track_slot = slots_[slot];
+    if (!track_slot.active)
         return true;
-    if (tracks_.at(track_id).lost > params_.forget_delay) {
-        active_track_ids_.erase(track_id);
+    if (track_slot.track.lost > params_.forget_delay) {
+        track_slot.active = false;
         return true;
     }
     return false;
 }
 
-bool Tracker::UptateLostTrackAndEraseIfItsNeeded(size_t track_id) {
-    tracks_.at(track_id).lost++;
-    bool erased = EraseTrackIfBBoxIsOutOfFrame(track_id);
+bool Tracker::UptateLostTrackAndEraseIfItsNeeded(size_t slot) {
+    slots_[slot].track.lost++;
+    bool erased = EraseTrackIfBBoxIsOutOfFrame(slot);
     if (!erased)
-        erased = EraseTrackIfItWasLostTooManyFramesAgo(track_id);
+        erased = EraseTrackIfItWasLostTooManyFramesAgo(slot);
     return erased;
 }
 
-void Tracker::UpdateLostTracks(const std::set<size_t> &track_ids) {
-    for (auto track_id : track_ids) {
-        UptateLostTrackAndEraseIfItsNeeded(track_id);
+void Tracker::UpdateLostTracks(const std::set<size_t> &slots) {
+    for (auto slot : slots) {
+        UptateLostTrackAndEraseIfItsNeeded(slot);
     }
 }
 
@@ -160,7 +324,7 @@ void Tracker::Process() {
     }
     ++frame_number;
 
-    auto active_tracks = active_track_ids_;
+    const std::vector<size_t> active_tracks = active_slots_;
 
     if (!active_tracks.empty() && !detections_.empty()) {
         std::set<size_t> unmatched_tracks, unmatched_detections;
@@ -169,66 +333,84 @@ void Tracker::Process() {
         SolveAssignmentProblem(active_tracks, detections_, &unmatched_tracks, &unmatched_detections, &matches);
 
         for (const auto &match : matches) {
-            size_t track_id = std::get<0>(match);
+            size_t slot = std::get<0>(match);
             size_t det_id = std::get<1>(match);
             float conf = std::get<2>(match);
             if (conf > params_.affinity_thr) {
-                AppendToTrack(track_id, detections_[det_id]);
+                AppendToTrack(slot, detections_[det_id]);
                 unmatched_detections.erase(det_id);
             } else {
-                unmatched_tracks.insert(track_id);
+                unmatched_tracks.insert(slot);
             }
         }
 
         AddNewTracks(detections_, unmatched_detections);
         UpdateLostTracks(unmatched_tracks);
 
-        for (size_t id : active_tracks) {
-            EraseTrackIfBBoxIsOutOfFrame(id);
+        for (size_t slot : active_tracks) {
+            EraseTrackIfBBoxIsOutOfFrame(slot);
         }
     } else {
         AddNewTracks(detections_);
-        UpdateLostTracks(active_tracks);
+        for (size_t slot : active_tracks) {
+            UptateLostTrackAndEraseIfItsNeeded(slot);
+        }
+    }
+
+    // forgotten tracks leave active list keeping creation order of the rest
+    size_t kept = 0;
+    for (size_t i = 0; i < active_slots_.size(); i++) {
+        const size_t slot = active_slots_[i];
+        if (slots_[slot].active)
+            active_slots_[kept++] = slot;
+        else if (params_.drop_forgotten_tracks)
+            ReleaseTrack(slot);
     }
+    active_slots_.resize(kept);
 
-    if (params_.drop_forgotten_tracks)
-        DropForgottenTracks();
+    if (frame_number % kCompactionPeriod == 0)
+        Compact();
 }
 
 void Tracker::DropForgottenTracks() {
-    std::unordered_map<size_t, Track> new_tracks;
-    std::set<size_t> new_active_tracks;
-
-    size_t max_id = 0;
-    if (!active_track_ids_.empty())
-        max_id = *std::max_element(active_track_ids_.begin(), active_track_ids_.end());
-
-    const size_t kMaxTrackID = 10000;
-    bool reassign_id = max_id > kMaxTrackID;
-
-    size_t counter = 0;
-    for (const auto &pair : tracks_) {
-        if (!IsTrackForgotten(pair.first)) {
-            new_tracks.emplace(reassign_id ? counter : pair.first, pair.second);
-            new_active_tracks.emplace(reassign_id ? counter : pair.first);
-            counter++;
-
-        } else {
-            if (IsTrackValid(pair.first)) {
-                valid_tracks_counter_++;
-            }
-        }
+    for (size_t slot = 0; slot < slots_.size(); slot++) {
+        if (slots_[slot].used && !slots_[slot].active)
+            ReleaseTrack(slot);
     }
-    tracks_.swap(new_tracks);
-    active_track_ids_.swap(new_active_tracks);
+    Compact();
+}
 
-    tracks_counter_ = reassign_id ? counter : tracks_counter_;
+void Tracker::ReleaseTrack(size_t slot) {
+    CV_Assert(IsTrackForgotten(slot));
+    CV_Assert(!slots_[slot].active);
+    if (IsTrackValid(slot)) {
+        valid_tracks_counter_++;
+    }
+    slots_[slot].used = false;
+    free_slots_.push_back(slot);
 }
 
-void Tracker::DropForgottenTrack(size_t track_id) {
-    CV_Assert(IsTrackForgotten(track_id));
-    CV_Assert(active_track_ids_.count(track_id) == 0);
-    tracks_.erase(track_id);
+void Tracker::Compact() {
+    // storage is shrunk only when most of slots are free, e.g. after a crowd has left the scene
+    if (free_slots_.size() <= slots_.size() / 2)
+        return;
+
+    std::vector<size_t> new_slots(slots_.size());
+    size_t used = 0;
+    for (size_t slot = 0; slot < slots_.size(); slot++) {
+        if (!slots_[slot].used)
+            continue;
+        new_slots[slot] = used;
+        if (used != slot)
+            slots_[used] = std::move(slots_[slot]);
+        used++;
+    }
+    slots_.erase(slots_.begin() + used, slots_.end());
+    slots_.shrink_to_fit();
+    free_slots_.clear();
+    free_slots_.shrink_to_fit();
+    for (size_t &slot : active_slots_)
+        slot = new_slots[slot];
 }
 
 float Tracker::ShapeAffinity(const cv::Rect &trk, const cv::Rect &det) {
@@ -249,20 +431,6 @@ float Tracker::MotionAffinity(const cv::Rect &trk, const cv::Rect &det) {
     return exp(-params_.motion_affinity_w * (x_dist + y_dist));
 }
 
-void Tracker::ComputeDissimilarityMatrix(const std::set<size_t> &active_tracks, const TrackedObjects &detections,
-                                         cv::Mat *dissimilarity_matrix) {
-    dissimilarity_matrix->create(active_tracks.size(), detections.size(), CV_32F);
-    size_t i = 0;
-    for (auto id : active_tracks) {
-        auto ptr = dissimilarity_matrix->ptr<float>(i);
-        for (size_t j = 0; j < detections.size(); j++) {
-            auto last_det = tracks_.at(id).objects.back();
-            ptr[j] = Distance(last_det, detections[j]);
-        }
-        i++;
-    }
-}
-
 void Tracker::AddNewTracks(const TrackedObjects &detections) {
     for (size_t i = 0; i < detections.size(); i++) {
         AddNewTrack(detections[i]);
@@ -279,46 +447,65 @@ void Tracker::AddNewTracks(const TrackedObjects &detections, const std::set<size
 void Tracker::AddNewTrack(const TrackedObject &detection) {
     auto detection_with_id = detection;
     detection_with_id.object_id = tracks_counter_;
-    tracks_.emplace(std::pair<size_t, Track>(tracks_counter_, Track({detection_with_id})));
 
-    active_track_ids_.insert(tracks_counter_);
+    size_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot].track.Reset(tracks_counter_, detection_with_id);
+        slots_[slot].used = true;
+        slots_[slot].active = true;
+    } else {
+        const size_t max_history = params_.max_num_objects_in_track > 0 ? params_.max_num_objects_in_track : 0;
+        slot = slots_.size();
+        slots_.push_back({Track(tracks_counter_, detection_with_id, max_history), true, true});
+    }
+
+    active_slots_.push_back(slot);
     tracks_counter_++;
 }
 
-void Tracker::AppendToTrack(size_t track_id, const TrackedObject &detection) {
-    CV_Assert(!IsTrackForgotten(track_id));
+void Tracker::AppendToTrack(size_t slot, const TrackedObject &detection) {
+    CV_Assert(!IsTrackForgotten(slot));
 
-    auto detection_with_id = detection;
-    detection_with_id.object_id = track_id;
+    auto &track = slots_[slot].track;
 
-    auto &track = tracks_.at(track_id);
+    auto detection_with_id = detection;
+    detection_with_id.object_id = track.id;
+
+    const TrackedObject &previous = track.back();
+    if (detection.frame_idx > previous.frame_idx) {
+        const float frames = detection.frame_idx - previous.frame_idx;
+        const cv::Vec4f displacement((detection.rect.x - previous.rect.x) / frames,
+                                     (detection.rect.y - previous.rect.y) / frames,
+                                     (detection.rect.width - previous.rect.width) / frames,
+                                     (detection.rect.height - previous.rect.height) / frames);
+        track.velocity = track.size() > 1
+                             ? kVelocityWeight * displacement + (1 - kVelocityWeight) * track.velocity
+                             : displacement;
+    }
 
-    track.objects.emplace_back(detection_with_id);
+    // history is a ring buffer limited by max_num_objects_in_track, the oldest object is overwritten
+    track.objects.push_back(detection_with_id);
     track.lost = 0;
     track.length++;
-
-    if (params_.max_num_objects_in_track > 0) {
-        while (track.size() > static_cast<size_t>(params_.max_num_objects_in_track)) {
-            track.objects.erase(track.objects.begin());
-        }
-    }
 }
 
-float Tracker::Distance(const TrackedObject &obj1, const TrackedObject &obj2) {
+float Tracker::Distance(const cv::Rect &trk, const cv::Rect &det) {
     const float eps = 1e-6;
-    float shp_aff = ShapeAffinity(obj1.rect, obj2.rect);
+    float shp_aff = ShapeAffinity(trk, det);
     if (shp_aff < eps)
         return 1.0;
 
-    float mot_aff = MotionAffinity(obj1.rect, obj2.rect);
+    float mot_aff = MotionAffinity(trk, det);
     if (mot_aff < eps)
         return 1.0;
 
     return 1.0 - shp_aff * mot_aff;
 }
 
-bool Tracker::IsTrackValid(size_t id) const {
-    const auto &track = tracks_.at(id);
+bool Tracker::IsTrackValid(size_t slot) const {
+    const auto &track = slots_[slot].track;
     const auto &objects = track.objects;
     if (objects.empty()) {
         return false;
@@ -329,13 +516,14 @@ bool Tracker::IsTrackValid(size_t id) const {
     return true;
 }
 
-bool Tracker::IsTrackForgotten(size_t id) const {
-    return tracks_.at(id).lost > params_.forget_delay;
+bool Tracker::IsTrackForgotten(size_t slot) const {
+    return slots_[slot].track.lost > params_.forget_delay;
 }
 
 void Tracker::Reset() {
-    active_track_ids_.clear();
-    tracks_.clear();
+    slots_.clear();
+    free_slots_.clear();
+    active_slots_.clear();
 
     detections_.clear();
 
@@ -343,21 +531,23 @@ void Tracker::Reset() {
     valid_tracks_counter_ = 0;
 
     frame_size_ = cv::Size();
+    frame_number = 0;
+    labels_.clear();
 }
 
 size_t Tracker::Count() const {
     size_t count = valid_tracks_counter_;
-    for (const auto &pair : tracks_) {
-        count += (IsTrackValid(pair.first) ? 1 : 0);
+    for (size_t slot = 0; slot < slots_.size(); slot++) {
+        count += (slots_[slot].used && IsTrackValid(slot) ? 1 : 0);
     }
     return count;
 }
 
 TrackedObjects Tracker::TrackedDetections() const {
     TrackedObjects detections;
-    for (size_t idx : active_track_ids()) {
-        auto track = tracks_.at(idx);
-        if (IsTrackValid(idx) && !track.lost) {
+    for (size_t slot : active_slots_) {
+        const auto &track = slots_[slot].track;
+        if (IsTrackValid(slot) && !track.lost) {
             detections.emplace_back(track.objects.back());
         }
     }
@@ -366,9 +556,9 @@ TrackedObjects Tracker::TrackedDetections() const {
 
 TrackedObjects Tracker::TrackedDetectionsWithLabels() const {
     TrackedObjects detections;
-    for (size_t idx : active_track_ids()) {
-        const auto &track = tracks().at(idx);
-        if (IsTrackValid(idx) && !track.lost) {
+    for (size_t slot : active_slots_) {
+        const auto &track = slots_[slot].track;
+        if (IsTrackValid(slot) && !track.lost) {
             TrackedObject object = track.objects.back();
             size_t counter = 1;
             int start = track.objects.size() >= (size_t)params_.averaging_window_size
@@ -394,24 +584,57 @@ TrackedObjects Tracker::TrackedDetectionsWithLabels() const {
     return detections;
 }
 
-const std::unordered_map<size_t, Track> &Tracker::tracks() const {
-    return tracks_;
-}
-
 std::vector<Track> Tracker::vector_tracks() const {
-    std::set<size_t> keys;
-    for (auto &cur_pair : tracks()) {
-        keys.insert(cur_pair.first);
-    }
     std::vector<Track> vec_tracks;
-    for (size_t k : keys) {
-        vec_tracks.push_back(tracks().at(k));
+    for (const TrackSlot &slot : slots_) {
+        if (slot.used)
+            vec_tracks.push_back(slot.track);
     }
+    std::sort(vec_tracks.begin(), vec_tracks.end(), [](const Track &a, const Track &b) { return a.id < b.id; });
     return vec_tracks;
 }
 
+cv::Rect Tracker::PredictedRect(const Track &track, size_t frame_idx) const {
+    const TrackedObject &last = track.back();
+    const float frames = frame_idx > static_cast<size_t>(last.frame_idx) ? frame_idx - last.frame_idx : 0;
+    return cv::Rect(cvRound(last.rect.x + track.velocity[0] * frames),
+                    cvRound(last.rect.y + track.velocity[1] * frames),
+                    std::max(1, cvRound(last.rect.width + track.velocity[2] * frames)),
+                    std::max(1, cvRound(last.rect.height + track.velocity[3] * frames)));
+}
+
+void Tracker::PredictAndStore(GVA::VideoFrame &frame) {
+    const size_t current_frame = frame_number++;
+    const cv::Rect frame_rect(cv::Point(), frame_size_);
+
+    // skipped frame carries no evidence, so lost counters are not updated
+    for (size_t slot : active_slots_) {
+        const Track &track = slots_[slot].track;
+        if (track.lost || !IsTrackValid(slot))
+            continue;
+        const TrackedObject &last = track.back();
+        if (current_frame - last.frame_idx > params_.max_prediction_frames)
+            continue;
+
+        const cv::Rect rect = PredictedRect(track, current_frame) & frame_rect;
+        if (rect.area() <= 0)
+            continue;
+
+        auto label = labels_.find(last.label);
+        auto roi = frame.add_region(rect.x, rect.y, rect.width, rect.height,
+                                    label != labels_.end() ? label->second : std::string(), last.confidence);
+        if (last.label != TrackedObject::UNKNOWN_LABEL_IDX)
+            roi.detection().set_int("label_id", last.label);
+        roi.set_object_id(track.id + 1);
+    }
+}
+
 void Tracker::track(GstBuffer *buffer) {
     GVA::VideoFrame frame(buffer, video_info.get());
+    if (gva_buffer_is_inference_skipped(buffer) && frame.regions().empty()) {
+        PredictAndStore(frame);
+        return;
+    }
     FilterDetectionsAndStore(frame);
     Process();
 
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "hungarian_solver.h"
 #include "itracker.h"
 #include "tracked_objects.h"
 #include "video_frame.h"
@@ -51,15 +52,21 @@ struct TrackerParams {
     cv::Vec2f bbox_heights_range; ///< Bounding box heights range.
 
     bool drop_forgotten_tracks; ///< Drop forgotten tracks. If it's enabled it
-    /// disables an ability to get detection log.
+    /// disables an ability to get detection log. If it's disabled, memory used
+    /// by tracks grows with number of tracks seen. Enabled by default.
 
     int max_num_objects_in_track; ///< The number of objects in track is
     /// restricted by this parameter. If it is negative or zero, the max number of
-    /// objects in track is not restricted.
+    /// objects in track is not restricted and memory used by a track grows with
+    /// its duration. Default is 32.
 
     std::string objects_type; ///< The type of boxes which will be grabbed from
     /// detector. Boxes with other types are ignored.
 
+    size_t max_prediction_frames; ///< On frames where detection was skipped,
+    /// tracks are extrapolated with constant velocity for at most this number of
+    /// frames after the last detection.
+
     ///
     /// Default constructor.
     ///
@@ -130,67 +137,68 @@ class Tracker : public ITracker {
 
     ///
     /// \brief IsTrackForgotten returns true if track is forgotten.
-    /// \param id Track ID.
+    /// \param slot Slot of the track.
     /// \return true if track is forgotten.
     ///
-    bool IsTrackForgotten(size_t id) const;
-
-    ///
-    /// \brief tracks Returns all tracks including forgotten (lost too many frames
-    /// ago).
-    /// \return Set of tracks {id, track}.
-    ///
-    const std::unordered_map<size_t, Track> &tracks() const;
+    bool IsTrackForgotten(size_t slot) const;
 
     ///
-    /// \brief tracks Returns all tracks including forgotten (lost too many frames
-    /// ago).
-    /// \return Vector of tracks
+    /// \brief tracks Returns all kept tracks including forgotten (lost too many
+    /// frames ago) if they are not dropped.
+    /// \return Vector of tracks ordered by track ID.
     ///
     std::vector<Track> vector_tracks() const;
 
     ///
     /// \brief IsTrackValid Checks whether track is valid (duration > threshold).
-    /// \param id Index of checked track.
+    /// \param slot Slot of the checked track.
     /// \return True if track duration exceeds some predefined value.
     ///
-    bool IsTrackValid(size_t id) const;
+    bool IsTrackValid(size_t slot) const;
 
     ///
     /// \brief DropForgottenTracks Removes tracks from memory that were lost too
-    /// many frames ago.
+    /// many frames ago and compacts track storage.
     ///
     void DropForgottenTracks();
 
     ///
-    /// \brief Process given frame.
+    /// \brief Process given frame. Frame on which detection was skipped gets
+    /// regions extrapolated from active tracks instead.
     /// \param buffer Input gst buffer
     ///
     void track(GstBuffer *buffer) override;
 
   private:
     void Process();
-    void DropForgottenTrack(size_t track_id);
-
-    const std::set<size_t> &active_track_ids() const {
-        return active_track_ids_;
-    }
+    void ReleaseTrack(size_t slot);
+    void Compact();
 
     float ShapeAffinity(const cv::Rect &trk, const cv::Rect &det);
     float MotionAffinity(const cv::Rect &trk, const cv::Rect &det);
 
-    void SolveAssignmentProblem(const std::set<size_t> &track_ids, const TrackedObjects &detections,
+    void SolveAssignmentProblem(const std::vector<size_t> &track_slots, const TrackedObjects &detections,
                                 std::set<size_t> *unmatched_tracks, std::set<size_t> *unmatched_detections,
                                 std::set<std::tuple<size_t, size_t, float>> *matches);
     void FilterDetectionsAndStore(GVA::VideoFrame &roi_list);
+    void PredictAndStore(GVA::VideoFrame &frame);
+    cv::Rect PredictedRect(const Track &track, size_t frame_idx) const;
+
+    struct AssignmentCandidate {
+        size_t track;     ///< Index of track in track_slots passed to SolveAssignmentProblem
+        size_t detection; ///< Index of detection
+        float dissimilarity;
+    };
 
-    void ComputeDissimilarityMatrix(const std::set<size_t> &active_track_ids, const TrackedObjects &detections,
-                                    cv::Mat *dissimilarity_matrix);
+    void FindAssignmentCandidates(const std::vector<cv::Rect> &predicted, const TrackedObjects &detections);
+    void SolveComponent(std::vector<AssignmentCandidate>::const_iterator begin,
+                        std::vector<AssignmentCandidate>::const_iterator end, const std::vector<size_t> &track_slots,
+                        std::set<std::tuple<size_t, size_t, float>> *matches);
 
     std::vector<std::pair<size_t, size_t>>
     GetTrackToDetectionIds(const std::set<std::tuple<size_t, size_t, float>> &matches);
 
-    float Distance(const TrackedObject &obj1, const TrackedObject &obj2);
+    float Distance(const cv::Rect &trk, const cv::Rect &det);
 
     void AddNewTrack(const TrackedObject &detection);
 
@@ -198,26 +206,33 @@ class Tracker : public ITracker {
 
     void AddNewTracks(const TrackedObjects &detections, const std::set<size_t> &ids);
 
-    void AppendToTrack(size_t track_id, const TrackedObject &detection);
+    void AppendToTrack(size_t slot, const TrackedObject &detection);
 
-    bool EraseTrackIfBBoxIsOutOfFrame(size_t track_id);
+    bool EraseTrackIfBBoxIsOutOfFrame(size_t slot);
 
-    bool EraseTrackIfItWasLostTooManyFramesAgo(size_t track_id);
+    bool EraseTrackIfItWasLostTooManyFramesAgo(size_t slot);
 
-    bool UptateLostTrackAndEraseIfItsNeeded(size_t track_id);
+    bool UptateLostTrackAndEraseIfItsNeeded(size_t slot);
 
-    void UpdateLostTracks(const std::set<size_t> &track_ids);
+    void UpdateLostTracks(const std::set<size_t> &slots);
 
     std::unordered_map<size_t, std::vector<cv::Point>> GetActiveTracks();
 
     // Parameters of the pipeline.
     TrackerParams params_;
 
-    // Indexes of active tracks.
-    std::set<size_t> active_track_ids_;
+    // Tracks are stored in a flat slot map. Slots of dropped tracks are put
+    // into free list and reused with their memory by new tracks.
+    struct TrackSlot {
+        Track track;
+        bool used;   // slot holds active or kept forgotten track
+        bool active; // track is not forgotten
+    };
+    std::vector<TrackSlot> slots_;
+    std::vector<size_t> free_slots_;
 
-    // All tracks.
-    std::unordered_map<size_t, Track> tracks_;
+    // Slots of active tracks in order of track creation.
+    std::vector<size_t> active_slots_;
 
     // Recent detections.
     TrackedObjects detections_;
@@ -231,7 +246,21 @@ class Tracker : public ITracker {
     cv::Size frame_size_;
     size_t frame_number;
 
+    // Label names by label id, used for regions added on skipped frames.
+    std::unordered_map<int, std::string> labels_;
+
     std::unique_ptr<GstVideoInfo, std::function<void(GstVideoInfo *)>> video_info;
+
+    // Buffers of SolveAssignmentProblem kept between frames to avoid reallocation.
+    std::vector<AssignmentCandidate> candidates_;
+    std::vector<size_t> grid_cell_begin_;
+    std::vector<size_t> grid_items_;
+    std::vector<size_t> grid_fill_;
+    std::vector<size_t> component_parent_;
+    std::vector<size_t> component_index_;
+    std::vector<float> component_costs_;
+    std::vector<size_t> component_assignment_;
+    HungarianSolver<float> assignment_solver_;
 };
 
 int LabelWithMaxFrequencyInTrack(const Track &track);
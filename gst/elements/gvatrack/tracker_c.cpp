@@ -7,6 +7,7 @@
 #include "tracker_c.h"
 #include "iou/tracker.h"
 #include "tracker_factory.h"
+#include "tracking_service.h"
 #include "utils.h"
 
 ITracker *acquire_tracker_instance(const GstVideoInfo *info, GstGvaTrackingType tracking_type, GError **error) {
@@ -42,3 +43,38 @@ void release_tracker_instance(ITracker *tracker) {
         GST_ERROR("%s", e.what());
     }
 }
+
+gint tracking_service_add_stream(ITracker *tracker, TrackedBufferCallback callback, gpointer user_data,
+                                 GError **error) {
+    try {
+        return static_cast<gint>(TrackingService::Instance().AddStream(tracker, callback, user_data));
+    } catch (const std::exception &e) {
+        g_set_error(error, 1, 1, "%s", Utils::createNestedErrorMsg(e).c_str());
+    }
+    return -1;
+}
+
+void tracking_service_submit(gint stream_id, GstBuffer *buffer, GError **error) {
+    try {
+        TrackingService::Instance().Submit(stream_id, buffer);
+    } catch (const std::exception &e) {
+        gst_buffer_unref(buffer);
+        g_set_error(error, 1, 1, "%s", Utils::createNestedErrorMsg(e).c_str());
+    }
+}
+
+void tracking_service_drain(gint stream_id) {
+    try {
+        TrackingService::Instance().Drain(stream_id);
+    } catch (const std::exception &e) {
+        GST_ERROR("%s", e.what());
+    }
+}
+
+void tracking_service_remove_stream(gint stream_id) {
+    try {
+        TrackingService::Instance().RemoveStream(stream_id);
+    } catch (const std::exception &e) {
+        GST_ERROR("%s", e.what());
+    }
+}
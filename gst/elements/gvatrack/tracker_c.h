@@ -23,4 +23,14 @@ ITracker *acquire_tracker_instance(const GstVideoInfo *info, GstGvaTrackingType
 void transform_tracked_objects(ITracker *tracker, GstBuffer *buffer, GError **error);
 void release_tracker_instance(ITracker *tracker);
 
+// Shared tracking service, see tracking_service.h
+typedef void (*TrackedBufferCallback)(GstBuffer *buffer, const gchar *error_message, gpointer user_data);
+// Takes ownership of tracker, returns stream id or -1 on error
+gint tracking_service_add_stream(ITracker *tracker, TrackedBufferCallback callback, gpointer user_data,
+                                 GError **error);
+// Takes ownership of buffer reference
+void tracking_service_submit(gint stream_id, GstBuffer *buffer, GError **error);
+void tracking_service_drain(gint stream_id);
+void tracking_service_remove_stream(gint stream_id);
+
 G_END_DECLS
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "tracking_service.h"
+
+#include "inference_backend/logger.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+TrackingService &TrackingService::Instance() {
+    static TrackingService service;
+    return service;
+}
+
+// tracking is cheap compared to inference, half of cores keeps most of them for decode and inference
+TrackingService::TrackingService()
+    : workers_number(std::max(1u, std::thread::hardware_concurrency() / 2)), stopped(false) {
+    for (unsigned i = 0; i < workers_number; i++)
+        workers.emplace_back(&TrackingService::Run, this);
+}
+
+TrackingService::~TrackingService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    condition.notify_all();
+    for (std::thread &worker : workers)
+        if (worker.joinable())
+            worker.join();
+}
+
+size_t TrackingService::AddStream(ITracker *tracker, Callback callback, void *user_data) {
+    std::unique_ptr<ITracker> owned_tracker(tracker);
+    if (!tracker || !callback)
+        throw std::invalid_argument("Tracker and callback are required to add stream to tracking service");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t stream_id;
+    if (!free_streams.empty()) {
+        stream_id = free_streams.back();
+        free_streams.pop_back();
+    } else {
+        stream_id = streams.size();
+        streams.emplace_back();
+    }
+    Stream &stream = streams[stream_id];
+    stream.tracker = std::move(owned_tracker);
+    stream.callback = callback;
+    stream.user_data = user_data;
+    stream.queued = false;
+    stream.used = true;
+    return stream_id;
+}
+
+void TrackingService::RemoveStream(size_t stream_id) {
+    std::unique_ptr<ITracker> tracker;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stream_id >= streams.size() || !streams[stream_id].used)
+            throw std::invalid_argument("Unknown tracking service stream " + std::to_string(stream_id));
+        completed.wait(lock, [this, stream_id] { return !streams[stream_id].queued; });
+        Stream &stream = streams[stream_id];
+        tracker = std::move(stream.tracker);
+        stream.used = false;
+        free_streams.push_back(stream_id);
+    }
+    // tracker is destroyed outside of the lock
+}
+
+void TrackingService::Submit(size_t stream_id, GstBuffer *buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stream_id >= streams.size() || !streams[stream_id].used)
+        throw std::invalid_argument("Unknown tracking service stream " + std::to_string(stream_id));
+    Stream &stream = streams[stream_id];
+    stream.pending.push_back(buffer);
+    if (!stream.queued) {
+        stream.queued = true;
+        ready.push_back(stream_id);
+        condition.notify_one();
+    }
+}
+
+void TrackingService::Drain(size_t stream_id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stream_id >= streams.size() || !streams[stream_id].used)
+        return;
+    completed.wait(lock, [this, stream_id] { return !streams[stream_id].queued; });
+}
+
+void TrackingService::Run() {
+    // upper bound keeps latency of the last stream of the pass low
+    constexpr size_t MAX_STREAMS_PER_PASS = 16;
+    std::vector<StreamBatch> batches;
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return stopped || !ready.empty(); });
+        if (ready.empty())
+            return; // stopped
+        const size_t streams_number =
+            std::min(MAX_STREAMS_PER_PASS, (ready.size() + workers_number - 1) / workers_number);
+        batches.resize(streams_number);
+        for (StreamBatch &batch : batches) {
+            batch.stream_id = ready.front();
+            ready.pop_front();
+            Stream &stream = streams[batch.stream_id];
+            batch.frames.assign(stream.pending.begin(), stream.pending.end());
+            stream.pending.clear();
+            batch.tracker = stream.tracker.get();
+            batch.callback = stream.callback;
+            batch.user_data = stream.user_data;
+        }
+        lock.unlock();
+
+        ITT_TASK("TrackingService::Run batch");
+        for (StreamBatch &batch : batches) {
+            for (GstBuffer *buffer : batch.frames) {
+                std::string error_message;
+                try {
+                    // element's reference to the buffer is usually released by now, copy is made only if buffer is
+                    // shared (e.g. with other tee branch)
+                    buffer = gst_buffer_make_writable(buffer);
+                    batch.tracker->track(buffer);
+                } catch (const std::exception &e) {
+                    error_message = Utils::createNestedErrorMsg(e);
+                }
+                // callback only queues the buffer, so a stalled stream does not hold the worker
+                batch.callback(buffer, error_message.c_str(), batch.user_data);
+            }
+        }
+
+        lock.lock();
+        for (StreamBatch &batch : batches) {
+            Stream &processed = streams[batch.stream_id];
+            if (!processed.pending.empty()) {
+                // frames arrived while batch was tracked, stream goes to the end of queue to keep streams fair
+                ready.push_back(batch.stream_id);
+                condition.notify_one();
+            } else {
+                processed.queued = false;
+                completed.notify_all();
+            }
+        }
+    }
+}
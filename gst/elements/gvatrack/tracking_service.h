@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "itracker.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Process-wide pool of worker threads shared by gvatrack elements. Each element registers its tracker as a stream
+// and submits frames to one work queue. A stream is processed by at most one worker at a time and all frames queued
+// for it are tracked in one go, so frames of a stream are completed in submission order. A worker takes pending frames
+// of several ready streams in one pass, ready streams are shared evenly among workers
+class TrackingService {
+  public:
+    // Called on worker thread for each tracked frame in submission order. Error message is empty on success.
+    // Workers are shared by all streams, so the callback must not block (e.g. push downstream) and should only hand
+    // the buffer over to the thread of the stream
+    using Callback = void (*)(GstBuffer *buffer, const char *error_message, void *user_data);
+
+    static TrackingService &Instance();
+
+    ~TrackingService();
+
+    TrackingService(const TrackingService &) = delete;
+    TrackingService &operator=(const TrackingService &) = delete;
+
+    // Takes ownership of tracker, returns stream id
+    size_t AddStream(ITracker *tracker, Callback callback, void *user_data);
+    // Waits for submitted frames to complete and destroys tracker of the stream
+    void RemoveStream(size_t stream_id);
+    // Takes ownership of buffer reference, it is passed back through the callback. Does not block, caller limits
+    // number of frames in flight of the stream
+    void Submit(size_t stream_id, GstBuffer *buffer);
+    // Blocks until all frames submitted for the stream are completed. Must not be called from the callback
+    void Drain(size_t stream_id);
+
+  private:
+    TrackingService();
+    void Run();
+
+    // Per-stream state is kept in a contiguous array indexed by stream id, slots of removed streams are reused.
+    // Workers copy what they need under the lock, so the array may grow while streams are processed
+    struct Stream {
+        std::unique_ptr<ITracker> tracker;
+        Callback callback;
+        void *user_data;
+        std::deque<GstBuffer *> pending;
+        bool queued; // stream is in ready queue or being processed by a worker
+        bool used;
+    };
+
+    std::vector<Stream> streams;
+    std::vector<size_t> free_streams;
+    std::deque<size_t> ready;
+
+    // Frames of one stream taken by worker in one pass
+    struct StreamBatch {
+        size_t stream_id;
+        ITracker *tracker;
+        Callback callback;
+        void *user_data;
+        std::vector<GstBuffer *> frames;
+    };
+
+    const size_t workers_number;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable completed;
+    bool stopped;
+};
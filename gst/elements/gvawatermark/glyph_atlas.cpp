@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "glyph_atlas.h"
+
+#include <opencv2/imgproc.hpp>
+
+constexpr char GlyphAtlas::FIRST_SYMBOL;
+constexpr char GlyphAtlas::LAST_SYMBOL;
+
+GlyphAtlas::GlyphAtlas(int font_face, double font_scale, int thickness) {
+    padding = thickness + 1;
+    int descent = 0;
+    ascent = cv::getTextSize(" ", font_face, font_scale, thickness, &descent).height;
+    // Hershey glyph strokes may reach thickness beyond advance of the glyph
+    extra_width = thickness + 2 * padding;
+
+    int atlas_width = 0;
+    for (char symbol = FIRST_SYMBOL; symbol <= LAST_SYMBOL; symbol++) {
+        const int advance = cv::getTextSize(std::string(1, symbol), font_face, font_scale, thickness, nullptr).width -
+                            thickness;
+        glyphs.push_back({atlas_width, advance});
+        atlas_width += advance + extra_width;
+    }
+
+    atlas = cv::Mat::zeros(ascent + descent + 2 * padding, atlas_width, CV_8UC1);
+    for (char symbol = FIRST_SYMBOL; symbol <= LAST_SYMBOL; symbol++) {
+        const Glyph &glyph = GetGlyph(symbol);
+        cv::putText(atlas, std::string(1, symbol), cv::Point(glyph.x + padding, padding + ascent), font_face,
+                    font_scale, cv::Scalar(255), thickness, cv::LINE_AA);
+    }
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::GetGlyph(char symbol) const {
+    if (symbol < FIRST_SYMBOL || symbol > LAST_SYMBOL)
+        symbol = '?';
+    return glyphs[symbol - FIRST_SYMBOL];
+}
+
+cv::Size GlyphAtlas::GetMaskSize(const std::string &text) const {
+    int width = extra_width;
+    for (char symbol : text)
+        width += GetGlyph(symbol).advance;
+    return cv::Size(width, atlas.rows);
+}
+
+cv::Point GlyphAtlas::Origin() const {
+    return cv::Point(padding, padding + ascent);
+}
+
+void GlyphAtlas::Render(const std::string &text, cv::Mat &mask) const {
+    mask.create(GetMaskSize(text), CV_8UC1);
+    mask.setTo(0);
+    int x = 0;
+    for (char symbol : text) {
+        const Glyph &glyph = GetGlyph(symbol);
+        const int cell_width = glyph.advance + extra_width;
+        // padding of neighbouring cells overlaps, maximum keeps antialiased edges of both glyphs
+        cv::Mat target = mask(cv::Rect(x, 0, cell_width, atlas.rows));
+        cv::max(target, atlas(cv::Rect(glyph.x, 0, cell_width, atlas.rows)), target);
+        x += glyph.advance;
+    }
+}
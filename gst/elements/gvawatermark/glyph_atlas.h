@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <string>
+#include <vector>
+
+// Printable ASCII glyphs of Hershey font rasterized once into single 8-bit opacity image. Text is composed by
+// copying glyph cells side by side instead of drawing font strokes for every label on every frame
+class GlyphAtlas {
+  public:
+    GlyphAtlas(int font_face, double font_scale, int thickness);
+
+    // Composes opacity mask of text. Text baseline starts at Origin() of the mask. Characters out of printable
+    // ASCII range are drawn as '?'
+    void Render(const std::string &text, cv::Mat &mask) const;
+    cv::Size GetMaskSize(const std::string &text) const;
+    cv::Point Origin() const;
+
+  private:
+    struct Glyph {
+        int x;       // position of glyph cell in atlas
+        int advance; // pen shift to the next glyph
+    };
+
+    const Glyph &GetGlyph(char symbol) const;
+
+    static constexpr char FIRST_SYMBOL = ' ';
+    static constexpr char LAST_SYMBOL = '~';
+
+    std::vector<Glyph> glyphs;
+    cv::Mat atlas;
+    int padding;     // margin around glyph strokes, so antialiased edges are not cut
+    int ascent;      // distance from top of cell to baseline, excluding padding
+    int extra_width; // cell width minus advance
+};
@@ -10,6 +10,7 @@
 #include <gst/gst.h>
 
 #include "gva_caps.h"
+#include "label_cache.h"
 #include "watermark.h"
 
 #include "config.h"
@@ -67,7 +68,7 @@ static void gst_gva_watermark_class_init(GstGvaWatermarkClass *klass) {
 }
 
 static void gst_gva_watermark_init(GstGvaWatermark *gvawatermark) {
-    UNUSED(gvawatermark);
+    gvawatermark->label_cache = NULL;
 }
 
 void gst_gva_watermark_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec) {
@@ -113,6 +114,8 @@ void gst_gva_watermark_finalize(GObject *object) {
 
     GST_DEBUG_OBJECT(gvawatermark, "finalize");
     /* clean up object here */
+    release_label_cache(gvawatermark->label_cache);
+    gvawatermark->label_cache = NULL;
 
     G_OBJECT_CLASS(gst_gva_watermark_parent_class)->finalize(object);
 }
@@ -121,6 +124,16 @@ static gboolean gst_gva_watermark_start(GstBaseTransform *trans) {
     GstGvaWatermark *gvawatermark = GST_GVA_WATERMARK(trans);
 
     GST_DEBUG_OBJECT(gvawatermark, "start");
+
+    // glyph atlas is rasterized once per element and kept across restarts
+    if (!gvawatermark->label_cache) {
+        gvawatermark->label_cache = create_label_cache();
+        if (!gvawatermark->label_cache) {
+            GST_ELEMENT_ERROR(gvawatermark, RESOURCE, FAILED, ("watermark has failed to initialize"),
+                              ("failed to create label cache"));
+            return FALSE;
+        }
+    }
     return TRUE;
 }
 
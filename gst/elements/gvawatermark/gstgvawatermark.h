@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (C) 2018-2019 Intel Corporation
+ * Copyright (C) 2018-2020 Intel Corporation
  *
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
@@ -24,6 +24,7 @@ typedef struct _GstGvaWatermarkClass GstGvaWatermarkClass;
 struct _GstGvaWatermark {
     GstBaseTransform base_gvawatermark;
     GstVideoInfo info;
+    struct LabelCache *label_cache;
 };
 
 struct _GstGvaWatermarkClass {
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "label_cache.h"
+
+#include "inference_backend/logger.h"
+#include "utils.h"
+
+#include <opencv2/imgproc.hpp>
+
+LabelCache::LabelCache() : atlas(cv::FONT_HERSHEY_TRIPLEX, 1, 1), labels(LABEL_CACHE_SIZE) {
+}
+
+const cv::Mat &LabelCache::GetMask(int object_id, const std::string &text) {
+    if (object_id <= 0) {
+        atlas.Render(text, scratch);
+        return scratch;
+    }
+    if (!labels.count(object_id))
+        labels.put(object_id);
+    Label &label = labels.get(object_id);
+    if (label.mask.empty() || label.text != text) {
+        label.text = text;
+        atlas.Render(text, label.mask);
+    }
+    return label.mask;
+}
+
+cv::Point LabelCache::Origin() const {
+    return atlas.Origin();
+}
+
+struct LabelCache *create_label_cache(void) {
+    try {
+        return new LabelCache();
+    } catch (const std::exception &e) {
+        GVA_ERROR(Utils::createNestedErrorMsg(e).c_str());
+        return nullptr;
+    }
+}
+
+void release_label_cache(struct LabelCache *label_cache) {
+    delete label_cache;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+struct LabelCache;
+struct LabelCache *create_label_cache(void);
+void release_label_cache(struct LabelCache *label_cache);
+
+G_END_DECLS
+
+#ifdef __cplusplus
+#include "glyph_atlas.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "lru_cache.h"
+
+const size_t LABEL_CACHE_SIZE = 256;
+
+// Opacity masks of label text, rendered with glyph atlas. Masks of tracked objects are kept by object id and
+// re-rendered only when label text changes, labels of untracked objects are rendered into scratch mask
+struct LabelCache {
+    struct Label {
+        std::string text;
+        cv::Mat mask;
+    };
+
+    GlyphAtlas atlas;
+    LRUCache<int, Label> labels;
+    cv::Mat scratch;
+
+    LabelCache();
+
+    // Returned mask is valid until next call
+    const cv::Mat &GetMask(int object_id, const std::string &text);
+    // Position of text baseline start in masks
+    cv::Point Origin() const;
+};
+#endif
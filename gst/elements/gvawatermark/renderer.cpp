@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "renderer.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+inline int FloorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+// Opacity of pixel of subsampled plane is average opacity of mask pixels it covers
+void BlendMask(cv::Mat &plane, int subsampling, const cv::Mat &mask, const cv::Point &top_left,
+               const cv::Scalar &color) {
+    const int pixel_size = plane.channels();
+    const int channels = std::min(pixel_size, 3); // fourth channel of BGRx/BGRA/RGBA is left intact
+    const int area = subsampling * subsampling;
+    const int x0 = std::max(0, FloorDiv(top_left.x, subsampling));
+    const int y0 = std::max(0, FloorDiv(top_left.y, subsampling));
+    const int x1 = std::min(plane.cols, FloorDiv(top_left.x + mask.cols - 1, subsampling) + 1);
+    const int y1 = std::min(plane.rows, FloorDiv(top_left.y + mask.rows - 1, subsampling) + 1);
+    int values[3] = {0, 0, 0};
+    for (int c = 0; c < channels; c++)
+        values[c] = cv::saturate_cast<uint8_t>(color[c]);
+
+    for (int y = y0; y < y1; y++) {
+        uint8_t *pixel = plane.ptr<uint8_t>(y) + x0 * pixel_size;
+        for (int x = x0; x < x1; x++, pixel += pixel_size) {
+            int opacity = 0;
+            for (int dy = 0; dy < subsampling; dy++) {
+                const int mask_y = y * subsampling + dy - top_left.y;
+                if (mask_y < 0 || mask_y >= mask.rows)
+                    continue;
+                const uint8_t *mask_row = mask.ptr<uint8_t>(mask_y);
+                for (int dx = 0; dx < subsampling; dx++) {
+                    const int mask_x = x * subsampling + dx - top_left.x;
+                    if (mask_x >= 0 && mask_x < mask.cols)
+                        opacity += mask_row[mask_x];
+                }
+            }
+            opacity /= area;
+            if (opacity == 0)
+                continue;
+            for (int c = 0; c < channels; c++)
+                pixel[c] = static_cast<uint8_t>(pixel[c] + (values[c] - pixel[c]) * opacity / 255);
+        }
+    }
+}
+
+} // anonymous namespace
+
+Renderer::Renderer(const InferenceBackend::Image &image) : format(image.format), planes_number(0) {
+    const int width = image.width;
+    const int height = image.height;
+    // odd sizes round up, as GST_VIDEO_INFO_COMP_WIDTH/HEIGHT of 4:2:0 formats
+    const int chroma_width = (width + 1) / 2;
+    const int chroma_height = (height + 1) / 2;
+    switch (format) {
+    case InferenceBackend::FOURCC_BGR:
+        planes[planes_number++] = {cv::Mat(height, width, CV_8UC3, image.planes[0], image.stride[0]), 1};
+        break;
+    case InferenceBackend::FOURCC_BGRA:
+    case InferenceBackend::FOURCC_BGRX:
+    case InferenceBackend::FOURCC_RGBA:
+    case InferenceBackend::FOURCC_RGBX:
+        planes[planes_number++] = {cv::Mat(height, width, CV_8UC4, image.planes[0], image.stride[0]), 1};
+        break;
+    case InferenceBackend::FOURCC_NV12:
+        planes[planes_number++] = {cv::Mat(height, width, CV_8UC1, image.planes[0], image.stride[0]), 1};
+        planes[planes_number++] = {cv::Mat(chroma_height, chroma_width, CV_8UC2, image.planes[1], image.stride[1]), 2};
+        break;
+    case InferenceBackend::FOURCC_I420:
+        planes[planes_number++] = {cv::Mat(height, width, CV_8UC1, image.planes[0], image.stride[0]), 1};
+        planes[planes_number++] = {cv::Mat(chroma_height, chroma_width, CV_8UC1, image.planes[1], image.stride[1]), 2};
+        planes[planes_number++] = {cv::Mat(chroma_height, chroma_width, CV_8UC1, image.planes[2], image.stride[2]), 2};
+        break;
+    default:
+        throw std::invalid_argument("Unsupported image format for drawing: " + std::to_string(format));
+    }
+}
+
+void Renderer::ConvertColor(const cv::Scalar &bgr, cv::Scalar (&plane_colors)[MAX_PLANES_NUMBER]) const {
+    const double b = bgr[0], g = bgr[1], r = bgr[2];
+    // BT.601 limited range
+    const double y = 16 + 0.257 * r + 0.504 * g + 0.098 * b;
+    const double u = 128 - 0.148 * r - 0.291 * g + 0.439 * b;
+    const double v = 128 + 0.439 * r - 0.368 * g - 0.071 * b;
+    switch (format) {
+    case InferenceBackend::FOURCC_RGBA:
+    case InferenceBackend::FOURCC_RGBX:
+        plane_colors[0] = cv::Scalar(r, g, b);
+        break;
+    case InferenceBackend::FOURCC_NV12:
+        plane_colors[0] = cv::Scalar(y);
+        plane_colors[1] = cv::Scalar(u, v);
+        break;
+    case InferenceBackend::FOURCC_I420:
+        plane_colors[0] = cv::Scalar(y);
+        plane_colors[1] = cv::Scalar(u);
+        plane_colors[2] = cv::Scalar(v);
+        break;
+    default:
+        plane_colors[0] = bgr;
+        break;
+    }
+}
+
+void Renderer::DrawRectangle(const cv::Point2f &top_left, const cv::Point2f &bottom_right, const cv::Scalar &color) {
+    cv::Scalar plane_colors[MAX_PLANES_NUMBER];
+    ConvertColor(color, plane_colors);
+    for (int i = 0; i < planes_number; i++) {
+        const float subsampling = planes[i].subsampling;
+        cv::rectangle(planes[i].mat, top_left / subsampling, bottom_right / subsampling, plane_colors[i], 1);
+    }
+}
+
+void Renderer::DrawCircle(const cv::Point &center, int radius, const cv::Scalar &color) {
+    cv::Scalar plane_colors[MAX_PLANES_NUMBER];
+    ConvertColor(color, plane_colors);
+    for (int i = 0; i < planes_number; i++) {
+        const int subsampling = planes[i].subsampling;
+        cv::circle(planes[i].mat, center / subsampling, radius / subsampling, plane_colors[i], cv::FILLED);
+    }
+}
+
+void Renderer::DrawMask(const cv::Mat &mask, const cv::Point &top_left, const cv::Scalar &color) {
+    if (mask.empty())
+        return;
+    cv::Scalar plane_colors[MAX_PLANES_NUMBER];
+    ConvertColor(color, plane_colors);
+    for (int i = 0; i < planes_number; i++)
+        BlendMask(planes[i].mat, planes[i].subsampling, mask, top_left, plane_colors[i]);
+}
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/image.h"
+
+#include <opencv2/core.hpp>
+
+// Draws primitives directly into planes of mapped image. Colors are given in BGR order and converted to pixel
+// format of the image: channels are swapped for RGB formats, for NV12 and I420 luma is drawn into Y plane and
+// chroma into subsampled UV planes, so objects are colored instead of being drawn in gray
+class Renderer {
+  public:
+    explicit Renderer(const InferenceBackend::Image &image);
+
+    void DrawRectangle(const cv::Point2f &top_left, const cv::Point2f &bottom_right, const cv::Scalar &color);
+    void DrawCircle(const cv::Point &center, int radius, const cv::Scalar &color);
+    // Blends color with opacity from 8-bit mask, placed with its top left corner at given point
+    void DrawMask(const cv::Mat &mask, const cv::Point &top_left, const cv::Scalar &color);
+
+  private:
+    struct Plane {
+        cv::Mat mat;
+        int subsampling; // plane resolution is image resolution divided by this factor
+    };
+
+    static constexpr int MAX_PLANES_NUMBER = 3;
+
+    void ConvertColor(const cv::Scalar &bgr, cv::Scalar (&plane_colors)[MAX_PLANES_NUMBER]) const;
+
+    int format;
+    Plane planes[MAX_PLANES_NUMBER];
+    int planes_number;
+};
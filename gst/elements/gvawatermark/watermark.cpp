@@ -8,6 +8,8 @@
 #include "config.h"
 #include "glib.h"
 #include "gva_buffer_map.h"
+#include "label_cache.h"
+#include "renderer.h"
 #include "utils.h"
 #include "video_frame.h"
 #include <gst/allocators/gstdmabuf.h>
@@ -20,43 +22,9 @@ static const std::vector<cv::Scalar> color_table_C3 = {
     cv::Scalar(255, 85, 0),  cv::Scalar(85, 255, 0),  cv::Scalar(0, 255, 85),  cv::Scalar(0, 85, 255),
     cv::Scalar(85, 0, 255),  cv::Scalar(255, 0, 85)};
 
-static const std::vector<cv::Scalar> color_table_C1 = {cv::Scalar(0), cv::Scalar(255)};
-
-static cv::Scalar index2color(size_t index, int fourcc) {
-    if (fourcc == InferenceBackend::FOURCC_I420 or fourcc == InferenceBackend::FOURCC_NV12) {
-        return color_table_C1[index % color_table_C1.size()];
-    } else {
-        cv::Scalar color = color_table_C3[index % color_table_C3.size()];
-        if (fourcc == InferenceBackend::FOURCC_RGBA || fourcc == InferenceBackend::FOURCC_RGBX) {
-            std::swap(color[0], color[2]);
-        }
-
-        return color;
-    }
-}
-
-int Fourcc2OpenCVType(int fourcc) {
-    switch (fourcc) {
-    case InferenceBackend::FOURCC_NV12:
-        return CV_8UC1; // only Y plane
-    case InferenceBackend::FOURCC_BGRA:
-        return CV_8UC4;
-    case InferenceBackend::FOURCC_BGRX:
-        return CV_8UC4;
-    case InferenceBackend::FOURCC_BGRP:
-        return 0;
-    case InferenceBackend::FOURCC_BGR:
-        return CV_8UC3;
-    case InferenceBackend::FOURCC_RGBA:
-        return CV_8UC4;
-    case InferenceBackend::FOURCC_RGBX:
-        return CV_8UC4;
-    case InferenceBackend::FOURCC_RGBP:
-        return 0;
-    case InferenceBackend::FOURCC_I420:
-        return CV_8UC1; // only Y plane
-    }
-    return 0;
+// Colors are in BGR order, renderer converts them to pixel format of the frame
+static cv::Scalar index2color(size_t index) {
+    return color_table_C3[index % color_table_C3.size()];
 }
 
 static void clip_rect(double &x, double &y, double &w, double &h, GstVideoInfo *info) {
@@ -67,7 +35,7 @@ static void clip_rect(double &x, double &y, double &w, double &h, GstVideoInfo *
 }
 
 gboolean draw_label(GstGvaWatermark *gvawatermark, GstBuffer *buffer) {
-    // map GstBuffer to cv::Mat
+    // map GstBuffer to system memory
     InferenceBackend::Image image;
     BufferMapContext mapContext;
     GstMemory *mem = gst_buffer_get_memory(buffer, 0);
@@ -78,8 +46,9 @@ gboolean draw_label(GstGvaWatermark *gvawatermark, GstBuffer *buffer) {
         gva_buffer_map(buffer, image, mapContext, &gvawatermark->info, InferenceBackend::MemoryType::SYSTEM, mapFlags);
         auto mapContextPtr = std::unique_ptr<BufferMapContext, std::function<void(BufferMapContext *)>>(
             &mapContext, [&](BufferMapContext *mapContext) { gva_buffer_unmap(buffer, image, *mapContext); });
-        int format = Fourcc2OpenCVType(image.format);
-        cv::Mat mat(image.height, image.width, format, image.planes[0], gvawatermark->info.stride[0]);
+        if (!gvawatermark->label_cache)
+            throw std::runtime_error("Label cache is not created");
+        Renderer renderer(image);
 
         // construct text labels
         GVA::VideoFrame video_frame(buffer, &gvawatermark->info);
@@ -125,26 +94,27 @@ gboolean draw_label(GstGvaWatermark *gvawatermark, GstBuffer *buffer) {
                     tensor.format() == "landmark_points") {
                     std::vector<float> data = tensor.data<float>();
                     for (guint i = 0; i < data.size() / 2; i++) {
-                        cv::Scalar color = index2color(i, image.format);
+                        cv::Scalar color = index2color(i);
                         int x_lm = rect.x + rect.w * data[2 * i];
                         int y_lm = rect.y + rect.h * data[2 * i + 1];
-                        cv::circle(mat, cv::Point(x_lm, y_lm), 1 + static_cast<int>(0.012 * rect.w), color, -1);
+                        renderer.DrawCircle(cv::Point(x_lm, y_lm), 1 + static_cast<int>(0.012 * rect.w), color);
                     }
                 }
             }
 
             // draw rectangle
-            cv::Scalar color = index2color(color_index, image.format); // TODO: Is it good mapping to colors?
+            cv::Scalar color = index2color(color_index); // TODO: Is it good mapping to colors?
 
             cv::Point2f bbox_min(rect.x, rect.y);
             cv::Point2f bbox_max(rect.x + rect.w, rect.y + rect.h);
-            cv::rectangle(mat, bbox_min, bbox_max, color, 1);
+            renderer.DrawRectangle(bbox_min, bbox_max, color);
 
             // put text
-            cv::Point2f pos(rect.x, rect.y - 5.f);
+            cv::Point pos(rect.x, rect.y - 5.f);
             if (pos.y < 0)
                 pos.y = rect.y + 30.f;
-            cv::putText(mat, text, pos, cv::FONT_HERSHEY_TRIPLEX, 1, color, 1);
+            const cv::Mat &mask = gvawatermark->label_cache->GetMask(object_id, text);
+            renderer.DrawMask(mask, pos - gvawatermark->label_cache->Origin(), color);
         }
     } catch (const std::exception &e) {
         GST_ELEMENT_ERROR(gvawatermark, STREAM, FAILED, ("watermark has failed to draw label"),
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+/*
+ * Per-buffer latency tracer which does not depend on Intel ITT/VTune.
+ *
+ * Usage:
+ *   GST_TRACERS="gvalatencytracer(output=/tmp/trace.json,format=chrome)" gst-launch-1.0 ...
+ *
+ * Records buffer entry/exit for every element (matched by buffer PTS) together with ITT_TASK markers of inference
+ * elements (pre-processing, inference submit, StartAsync, completion callback, post-processing). Data is written to
+ * 'output' when EOS reaches a sink element, when process receives SIGUSR1 (unless application installed own handler)
+ * and on tracer destruction. 'format' is either 'chrome' (trace_event JSON for chrome://tracing or Perfetto) or
+ * 'summary' (per-element and per-stage latency table).
+ */
+
+#include "gst_latency_tracer.h"
+
+#include "inference_backend/latency_tracer.h"
+
+#include <errno.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <string.h>
+
+#define DEFAULT_OUTPUT "gva_latency_trace.json"
+
+#define UNUSED(x) (void)(x)
+
+GST_DEBUG_CATEGORY_STATIC(gst_gva_latency_tracer_debug);
+#define GST_CAT_DEFAULT gst_gva_latency_tracer_debug
+
+#define _do_init GST_DEBUG_CATEGORY_INIT(gst_gva_latency_tracer_debug, "gvalatencytracer", 0, "gva latency tracer");
+#define gst_gva_latency_tracer_parent_class parent_class
+
+G_DEFINE_TYPE_WITH_CODE(GstGvaLatencyTracer, gst_gva_latency_tracer, GST_TYPE_TRACER, _do_init);
+
+// Signal handler only posts semaphore (async-signal-safe), trace is written by dump thread right away instead of
+// waiting for next buffer push, which may never come if pipeline is stalled
+static sem_t dump_semaphore;
+static GstGvaLatencyTracer *signal_tracer = NULL;
+static struct sigaction previous_action;
+static GQuark element_name_quark = 0;
+
+static void on_dump_signal(int signum) {
+    UNUSED(signum);
+    sem_post(&dump_semaphore);
+}
+
+static void gst_gva_latency_tracer_dump(GstGvaLatencyTracer *self) {
+    g_mutex_lock(&self->dump_lock);
+    if (latency_tracer_dump(self->output, self->summary) == 0)
+        GST_INFO_OBJECT(self, "latency trace written to %s", self->output);
+    else
+        GST_WARNING_OBJECT(self, "failed to write latency trace to %s", self->output);
+    g_mutex_unlock(&self->dump_lock);
+}
+
+static gpointer gst_gva_latency_tracer_dump_thread(gpointer data) {
+    GstGvaLatencyTracer *self = GST_GVA_LATENCY_TRACER(data);
+    for (;;) {
+        if (sem_wait(&dump_semaphore) != 0) {
+            if (errno == EINTR)
+                continue;
+            GST_WARNING_OBJECT(self, "waiting for SIGUSR1 failed, trace is not written on signal");
+            break;
+        }
+        if (g_atomic_int_get(&self->dump_thread_stop))
+            break;
+        gst_gva_latency_tracer_dump(self);
+    }
+    return NULL;
+}
+
+static void gst_gva_latency_tracer_install_signal_handler(GstGvaLatencyTracer *self) {
+    // do not override handler installed by application, nor by other tracer instance
+    struct sigaction current;
+    if (sigaction(SIGUSR1, NULL, &current) != 0 || current.sa_handler != SIG_DFL ||
+        !g_atomic_pointer_compare_and_exchange(&signal_tracer, NULL, self))
+        return;
+
+    self->dump_thread = g_thread_new("gvalatencydump", gst_gva_latency_tracer_dump_thread, self);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_dump_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, &previous_action);
+}
+
+static void gst_gva_latency_tracer_remove_signal_handler(GstGvaLatencyTracer *self) {
+    if (!self->dump_thread)
+        return;
+    sigaction(SIGUSR1, &previous_action, NULL);
+    g_atomic_int_set(&self->dump_thread_stop, 1);
+    sem_post(&dump_semaphore);
+    g_thread_join(self->dump_thread);
+    self->dump_thread = NULL;
+    // drop signals which came after thread stopped
+    while (sem_trywait(&dump_semaphore) == 0)
+        ;
+    g_atomic_pointer_set(&signal_tracer, NULL);
+}
+
+static const gchar *get_element_name(GstObject *object) {
+    if (!object || !GST_IS_ELEMENT(object))
+        return NULL;
+    const gchar *name = g_object_get_qdata(G_OBJECT(object), element_name_quark);
+    if (!name) {
+        name = latency_tracer_intern(GST_OBJECT_NAME(object));
+        g_object_set_qdata(G_OBJECT(object), element_name_quark, (gpointer)name);
+    }
+    return name;
+}
+
+static guint64 get_buffer_id(GstBuffer *buffer) {
+    if (GST_BUFFER_PTS_IS_VALID(buffer))
+        return GST_BUFFER_PTS(buffer);
+    if (GST_BUFFER_DTS_IS_VALID(buffer))
+        return GST_BUFFER_DTS(buffer);
+    return (guint64)(guintptr)buffer;
+}
+
+static void record_buffer_push(GstPad *pad, GstBuffer *buffer) {
+    GstPad *peer = GST_PAD_PEER(pad);
+    if (!buffer || !peer)
+        return;
+
+    const guint64 id = get_buffer_id(buffer);
+    const guint64 now = latency_tracer_now();
+    const gchar *src_name = get_element_name(GST_OBJECT_PARENT(pad));
+    const gchar *sink_name = get_element_name(GST_OBJECT_PARENT(peer));
+    if (src_name)
+        latency_tracer_record(src_name, LATENCY_TRACER_ELEMENT_EXIT, id, now, 0);
+    if (sink_name)
+        latency_tracer_record(sink_name, LATENCY_TRACER_ELEMENT_ENTER, id, now, 0);
+}
+
+static void gst_gva_latency_tracer_hook_pad_push_pre(GObject *self, GstClockTime ts, GstPad *pad, GstBuffer *buffer) {
+    UNUSED(self);
+    UNUSED(ts);
+    record_buffer_push(pad, buffer);
+}
+
+static void gst_gva_latency_tracer_hook_pad_push_list_pre(GObject *self, GstClockTime ts, GstPad *pad,
+                                                          GstBufferList *list) {
+    UNUSED(self);
+    UNUSED(ts);
+    guint length = gst_buffer_list_length(list);
+    for (guint i = 0; i < length; i++)
+        record_buffer_push(pad, gst_buffer_list_get(list, i));
+}
+
+static void gst_gva_latency_tracer_hook_pad_push_event_pre(GObject *self, GstClockTime ts, GstPad *pad,
+                                                           GstEvent *event) {
+    UNUSED(ts);
+    if (GST_EVENT_TYPE(event) != GST_EVENT_EOS)
+        return;
+    GstPad *peer = GST_PAD_PEER(pad);
+    GstObject *element = peer ? GST_OBJECT_PARENT(peer) : NULL;
+    if (element && GST_IS_ELEMENT(element) && GST_OBJECT_FLAG_IS_SET(element, GST_ELEMENT_FLAG_SINK))
+        gst_gva_latency_tracer_dump(GST_GVA_LATENCY_TRACER(self));
+}
+
+static void gst_gva_latency_tracer_parse_params(GstGvaLatencyTracer *self) {
+    gchar *params = NULL;
+    g_object_get(self, "params", &params, NULL);
+    if (!params)
+        return;
+
+    gchar *structure_string = g_strdup_printf("gvalatencytracer,%s", params);
+    GstStructure *structure = gst_structure_from_string(structure_string, NULL);
+    if (structure) {
+        const gchar *output = gst_structure_get_string(structure, "output");
+        if (output) {
+            g_free(self->output);
+            self->output = g_strdup(output);
+        }
+        const gchar *format = gst_structure_get_string(structure, "format");
+        if (format)
+            self->summary = g_strcmp0(format, "summary") == 0;
+        gst_structure_free(structure);
+    } else {
+        GST_WARNING_OBJECT(self, "can't parse tracer parameters '%s'", params);
+    }
+    g_free(structure_string);
+    g_free(params);
+}
+
+static void gst_gva_latency_tracer_constructed(GObject *object) {
+    GstGvaLatencyTracer *self = GST_GVA_LATENCY_TRACER(object);
+
+    gst_gva_latency_tracer_parse_params(self);
+    GST_INFO_OBJECT(self, "output=%s, format=%s", self->output, self->summary ? "summary" : "chrome");
+    gst_gva_latency_tracer_install_signal_handler(self);
+
+    G_OBJECT_CLASS(parent_class)->constructed(object);
+}
+
+static void gst_gva_latency_tracer_finalize(GObject *object) {
+    GstGvaLatencyTracer *self = GST_GVA_LATENCY_TRACER(object);
+
+    gst_gva_latency_tracer_remove_signal_handler(self);
+    gst_gva_latency_tracer_dump(self);
+    latency_tracer_enable(0);
+    g_free(self->output);
+    self->output = NULL;
+    g_mutex_clear(&self->dump_lock);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gst_gva_latency_tracer_class_init(GstGvaLatencyTracerClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->constructed = gst_gva_latency_tracer_constructed;
+    gobject_class->finalize = gst_gva_latency_tracer_finalize;
+
+    element_name_quark = g_quark_from_static_string("gva-latency-tracer-name");
+    sem_init(&dump_semaphore, 0, 0);
+}
+
+static void gst_gva_latency_tracer_init(GstGvaLatencyTracer *self) {
+    self->output = g_strdup(DEFAULT_OUTPUT);
+    self->summary = FALSE;
+    g_mutex_init(&self->dump_lock);
+    self->dump_thread = NULL;
+    self->dump_thread_stop = 0;
+
+    gst_tracing_register_hook(GST_TRACER(self), "pad-push-pre",
+                              G_CALLBACK(gst_gva_latency_tracer_hook_pad_push_pre));
+    gst_tracing_register_hook(GST_TRACER(self), "pad-push-list-pre",
+                              G_CALLBACK(gst_gva_latency_tracer_hook_pad_push_list_pre));
+    gst_tracing_register_hook(GST_TRACER(self), "pad-push-event-pre",
+                              G_CALLBACK(gst_gva_latency_tracer_hook_pad_push_event_pre));
+
+    latency_tracer_enable(1);
+}
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#ifndef _GST_GVA_LATENCY_TRACER_H_
+#define _GST_GVA_LATENCY_TRACER_H_
+
+#include <gst/gst.h>
+#include <gst/gsttracer.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_GVA_LATENCY_TRACER (gst_gva_latency_tracer_get_type())
+#define GST_GVA_LATENCY_TRACER(obj)                                                                                    \
+    (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_GVA_LATENCY_TRACER, GstGvaLatencyTracer))
+
+typedef struct _GstGvaLatencyTracer GstGvaLatencyTracer;
+typedef struct _GstGvaLatencyTracerClass GstGvaLatencyTracerClass;
+
+struct _GstGvaLatencyTracer {
+    GstTracer parent;
+    gchar *output;
+    gboolean summary;
+    GMutex dump_lock;
+    GThread *dump_thread; /* writes trace on SIGUSR1, only for instance which installed signal handler */
+    gint dump_thread_stop;
+};
+
+struct _GstGvaLatencyTracerClass {
+    GstTracerClass parent_class;
+};
+
+GType gst_gva_latency_tracer_get_type(void);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "adaptive_interval.h"
+
+#include "inference_backend/logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// 32x18 cells keep 16:9 aspect, 4 sampled rows per cell: about 2% of luma plane is read per frame
+constexpr int GRID_WIDTH = 32;
+constexpr int GRID_HEIGHT = 18;
+constexpr int ROWS_PER_CELL = 4;
+constexpr int CELLS = GRID_WIDTH * GRID_HEIGHT;
+
+// Adds pixels of one row to cell sums. Cell of a 16-pixel chunk is chosen by its first pixel, small bleeding over
+// cell boundaries does not matter for motion estimation
+void AccumulateRow(const guint8 *row, int width, int pixel_stride, guint32 *sums, guint32 *counts) {
+    int x = 0;
+#ifdef __SSE2__
+    if (pixel_stride == 1) {
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 16 <= width; x += 16) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+            const __m128i sad = _mm_sad_epu8(pixels, zero); // two partial sums of 8 pixels each
+            const int cell = x * GRID_WIDTH / width;
+            sums[cell] += _mm_cvtsi128_si32(sad) + _mm_extract_epi16(sad, 4);
+            counts[cell] += 16;
+        }
+    }
+#endif
+    // packed RGB formats are subsampled by 2 horizontally, it is enough for thumbnail
+    const int step = pixel_stride == 1 ? 1 : 2;
+    for (; x < width; x += step) {
+        const int cell = x * GRID_WIDTH / width;
+        sums[cell] += row[x * pixel_stride];
+        counts[cell]++;
+    }
+}
+
+} // namespace
+
+AdaptiveInterval::AdaptiveInterval()
+    : current_valid(false), scene_changed(true), motion_score(0), interval(1), frames_since_inference(0),
+      last_objects(0), objects(0) {
+    reference.reserve(CELLS);
+    current.reserve(CELLS);
+}
+
+bool AdaptiveInterval::ComputeThumbnail(GstBuffer *buffer, GstVideoInfo *info, std::vector<float> &thumbnail) const {
+    ITT_TASK(__FUNCTION__);
+    // luma for YUV and gray formats, green channel approximates it for RGB formats
+    int component;
+    if (GST_VIDEO_INFO_IS_YUV(info) || GST_VIDEO_INFO_IS_GRAY(info))
+        component = 0;
+    else if (GST_VIDEO_INFO_IS_RGB(info))
+        component = 1;
+    else
+        return false;
+
+    GstVideoFrame frame;
+    if (!gst_video_frame_map(&frame, info, buffer, GST_MAP_READ))
+        return false;
+
+    const guint8 *data = static_cast<const guint8 *>(GST_VIDEO_FRAME_COMP_DATA(&frame, component));
+    const int stride = GST_VIDEO_FRAME_COMP_STRIDE(&frame, component);
+    const int pixel_stride = GST_VIDEO_FRAME_COMP_PSTRIDE(&frame, component);
+    const int width = GST_VIDEO_FRAME_COMP_WIDTH(&frame, component);
+    const int height = GST_VIDEO_FRAME_COMP_HEIGHT(&frame, component);
+    if (width <= 0 || height <= 0) {
+        gst_video_frame_unmap(&frame);
+        return false;
+    }
+
+    const int sampled_rows = GRID_HEIGHT * ROWS_PER_CELL;
+    thumbnail.assign(CELLS, 0.f);
+    for (int cell_row = 0; cell_row < GRID_HEIGHT; cell_row++) {
+        guint32 sums[GRID_WIDTH] = {};
+        guint32 counts[GRID_WIDTH] = {};
+        for (int i = 0; i < ROWS_PER_CELL; i++) {
+            const int y = ((cell_row * ROWS_PER_CELL + i) * 2 + 1) * height / (2 * sampled_rows);
+            AccumulateRow(data + static_cast<size_t>(y) * stride, width, pixel_stride, sums, counts);
+        }
+        for (int cell = 0; cell < GRID_WIDTH; cell++)
+            thumbnail[cell_row * GRID_WIDTH + cell] = counts[cell] ? static_cast<float>(sums[cell]) / counts[cell] : 0;
+    }
+
+    gst_video_frame_unmap(&frame);
+    return true;
+}
+
+bool AdaptiveInterval::IsInferenceNeeded(GstBuffer *buffer, GstVideoInfo *info, guint max_interval,
+                                         gdouble motion_threshold) {
+    ITT_TASK(__FUNCTION__);
+    frames_since_inference++;
+
+    // frame which can't be mapped or has unsupported format is treated as changed
+    current_valid = ComputeThumbnail(buffer, info, current);
+    if (current_valid && reference.size() == current.size()) {
+        float difference = 0;
+        for (size_t i = 0; i < current.size(); i++)
+            difference += std::fabs(current[i] - reference[i]);
+        motion_score = difference / current.size();
+    } else {
+        motion_score = 255;
+    }
+
+    const guint observed_objects = objects.load(std::memory_order_relaxed);
+    scene_changed = motion_score > motion_threshold || observed_objects != last_objects;
+    last_objects = observed_objects;
+
+    if (scene_changed)
+        interval = 1;
+    interval = std::min(interval, std::max(max_interval, 1u));
+    return frames_since_inference >= interval;
+}
+
+void AdaptiveInterval::OnInferenceSubmitted(guint max_interval) {
+    frames_since_inference = 0;
+    if (current_valid)
+        reference.swap(current);
+    else
+        reference.clear();
+    // back off only while nothing is detected, known objects keep current interval
+    if (!scene_changed && last_objects == 0)
+        interval = interval > max_interval / 2 ? std::max(max_interval, 1u) : interval * 2;
+}
+
+void AdaptiveInterval::SetObjectsCount(guint count) {
+    objects.store(count, std::memory_order_relaxed);
+}
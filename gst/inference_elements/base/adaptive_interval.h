@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <gst/video/video.h>
+
+#include <atomic>
+#include <vector>
+
+// Motion-gated inference interval for full-frame inference. Each frame is reduced to a small luma thumbnail and
+// compared with the thumbnail of the frame inference last ran on. Motion or a change in number of detected objects
+// drops the interval to 1, while scene stays static and empty the interval doubles up to 'inference-interval'
+class AdaptiveInterval {
+  public:
+    AdaptiveInterval();
+
+    // Called on streaming thread for every frame
+    bool IsInferenceNeeded(GstBuffer *buffer, GstVideoInfo *info, guint max_interval, gdouble motion_threshold);
+    // Called on streaming thread when inference is submitted for the frame passed to last IsInferenceNeeded()
+    void OnInferenceSubmitted(guint max_interval);
+    // Called on post-processing thread with number of objects found on inferred frame
+    void SetObjectsCount(guint count);
+
+    guint GetInterval() const {
+        return interval;
+    }
+    gdouble GetMotionScore() const {
+        return motion_score;
+    }
+
+  private:
+    bool ComputeThumbnail(GstBuffer *buffer, GstVideoInfo *info, std::vector<float> &thumbnail) const;
+
+    std::vector<float> reference; // thumbnail of the frame inference last ran on
+    std::vector<float> current;
+    bool current_valid;
+    bool scene_changed;
+    gdouble motion_score;
+    guint interval;
+    guint frames_since_inference;
+    guint last_objects;
+    std::atomic<guint> objects;
+};
@@ -22,6 +22,12 @@
 #define DEFAULT_MAX_INFERENCE_INTERVAL UINT_MAX
 #define DEFAULT_INFERENCE_INTERVAL 1
 
+#define DEFAULT_ADAPTIVE_INTERVAL FALSE
+
+#define DEFAULT_MIN_MOTION_THRESHOLD 0.
+#define DEFAULT_MAX_MOTION_THRESHOLD 255.
+#define DEFAULT_MOTION_THRESHOLD 2.
+
 #define DEFAULT_RESHAPE FALSE
 
 #define DEFAULT_MIN_BATCH_SIZE 1
@@ -38,9 +44,12 @@
 
 #define DEFAULT_NO_BLOCK FALSE
 
+#define DEFAULT_WARM_UP FALSE
+
 #define DEFAULT_MIN_NIREQ 0
 #define DEFAULT_MAX_NIREQ 1024
 #define DEFAULT_NIREQ 0
+#define DEFAULT_NIREQ_MAX 0
 
 #define DEFAULT_CPU_THROUGHPUT_STREAMS 0
 #define DEFAULT_MIN_CPU_THROUGHPUT_STREAMS 0
@@ -61,19 +70,24 @@ enum {
     PROP_MODEL,
     PROP_DEVICE,
     PROP_INFERENCE_INTERVAL,
+    PROP_ADAPTIVE_INTERVAL,
+    PROP_MOTION_THRESHOLD,
+    PROP_INFERENCE_RATE,
     PROP_RESHAPE,
     PROP_BATCH_SIZE,
     PROP_RESHAPE_WIDTH,
     PROP_RESHAPE_HEIGHT,
     PROP_NO_BLOCK,
     PROP_NIREQ,
+    PROP_NIREQ_MAX,
     PROP_MODEL_INSTANCE_ID,
     PROP_PRE_PROC_BACKEND,
     PROP_MODEL_PROC,
     PROP_CPU_THROUGHPUT_STREAMS,
     PROP_GPU_THROUGHPUT_STREAMS,
     PROP_IE_CONFIG,
-    PROP_DEVICE_EXTENSIONS
+    PROP_DEVICE_EXTENSIONS,
+    PROP_WARM_UP
 };
 
 static void gva_base_inference_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
@@ -159,6 +173,30 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
                           DEFAULT_MIN_INFERENCE_INTERVAL, DEFAULT_MAX_INFERENCE_INTERVAL, DEFAULT_INFERENCE_INTERVAL,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+    g_object_class_install_property(
+        gobject_class, PROP_ADAPTIVE_INTERVAL,
+        g_param_spec_boolean(
+            "adaptive-interval", "Adaptive inference interval",
+            "Applies to full-frame inference only. If true, 'inference-interval' is the maximum interval: inference "
+            "runs on every frame after motion or change in number of detected objects, and the interval doubles up to "
+            "'inference-interval' while scene stays static and no objects are detected",
+            DEFAULT_ADAPTIVE_INTERVAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_MOTION_THRESHOLD,
+        g_param_spec_double("motion-threshold", "Motion threshold",
+                            "Used with adaptive-interval=true. Mean absolute difference of downscaled luma (0-255) "
+                            "between current frame and last inferred frame above which scene is considered changed",
+                            DEFAULT_MIN_MOTION_THRESHOLD, DEFAULT_MAX_MOTION_THRESHOLD, DEFAULT_MOTION_THRESHOLD,
+                            G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_INFERENCE_RATE,
+        g_param_spec_double("inference-rate", "Effective inference rate",
+                            "Fraction of recent frames inference was run on (moving average over about 32 frames), "
+                            "for monitoring of inference-interval, adaptive-interval and no-block",
+                            0., 1., 1., G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
     g_object_class_install_property(
         gobject_class, PROP_RESHAPE,
         g_param_spec_boolean("reshape", "Reshape input layer",
@@ -194,6 +232,15 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
                                                       DEFAULT_MIN_NIREQ, DEFAULT_MAX_NIREQ, DEFAULT_NIREQ,
                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+    g_object_class_install_property(
+        gobject_class, PROP_NIREQ_MAX,
+        g_param_spec_uint("nireq-max", "NIReq-Max",
+                          "Upper bound for number of inference requests. If greater than 0, number of active requests "
+                          "is adapted at runtime between 1 and this value based on measured throughput and waiting for "
+                          "free request, decisions are logged at info level",
+                          DEFAULT_MIN_NIREQ, DEFAULT_MAX_NIREQ, DEFAULT_NIREQ_MAX,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
     g_object_class_install_property(
         gobject_class, PROP_CPU_THROUGHPUT_STREAMS,
         g_param_spec_uint("cpu-throughput-streams", "CPU-Throughput-Streams",
@@ -226,6 +273,13 @@ void gva_base_inference_class_init(GvaBaseInferenceClass *klass) {
             "device-extensions", "ExtensionString",
             "Comma separated list of KEY=VALUE pairs specifying the Inference Engine extension for a device",
             DEFAULT_DEVICE_EXTENSIONS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property(
+        gobject_class, PROP_WARM_UP,
+        g_param_spec_boolean("warm-up", "Warm up",
+                             "Run synthetic frame through pre-processing and every inference request after model is "
+                             "loaded, so that first frames do not pay for lazy allocations and kernel selection",
+                             DEFAULT_WARM_UP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 void gva_base_inference_cleanup(GvaBaseInference *base_inference) {
@@ -288,12 +342,19 @@ void gva_base_inference_init(GvaBaseInference *base_inference) {
     base_inference->device = g_strdup(DEFAULT_DEVICE);
     base_inference->model_proc = g_strdup(DEFAULT_MODEL_PROC);
     base_inference->inference_interval = DEFAULT_INFERENCE_INTERVAL;
+    base_inference->adaptive_interval = DEFAULT_ADAPTIVE_INTERVAL;
+    base_inference->motion_threshold = DEFAULT_MOTION_THRESHOLD;
+    // tiling properties are installed by gvadetect only, other elements infer whole frame
+    base_inference->tile_columns = 1;
+    base_inference->tile_rows = 1;
+    base_inference->tile_overlap = 0.;
     base_inference->reshape = DEFAULT_RESHAPE;
     base_inference->batch_size = DEFAULT_BATCH_SIZE;
     base_inference->reshape_width = DEFAULT_RESHAPE_WIDTH;
     base_inference->reshape_height = DEFAULT_RESHAPE_HEIGHT;
     base_inference->no_block = DEFAULT_NO_BLOCK;
     base_inference->nireq = DEFAULT_NIREQ;
+    base_inference->nireq_max = DEFAULT_NIREQ_MAX;
     base_inference->model_instance_id = g_strdup(DEFAULT_MODEL_INSTANCE_ID);
     base_inference->pre_proc_name = g_strdup(DEFAULT_PRE_PROC);
     // TODO: make one property for streams
@@ -302,10 +363,12 @@ void gva_base_inference_init(GvaBaseInference *base_inference) {
     base_inference->ie_config = g_strdup("");
     base_inference->allocator_name = g_strdup(DEFAULT_ALLOCATOR_NAME);
     base_inference->device_extensions = g_strdup(DEFAULT_DEVICE_EXTENSIONS);
+    base_inference->warm_up = DEFAULT_WARM_UP;
 
     base_inference->initialized = FALSE;
     base_inference->info = NULL;
     base_inference->is_full_frame = TRUE;
+    base_inference->inference_rate = 1.;
     base_inference->inference = NULL;
     base_inference->is_roi_classification_needed = NULL;
     base_inference->pre_proc = NULL;
@@ -374,6 +437,12 @@ void gva_base_inference_set_property(GObject *object, guint property_id, const G
     case PROP_INFERENCE_INTERVAL:
         base_inference->inference_interval = g_value_get_uint(value);
         break;
+    case PROP_ADAPTIVE_INTERVAL:
+        base_inference->adaptive_interval = g_value_get_boolean(value);
+        break;
+    case PROP_MOTION_THRESHOLD:
+        base_inference->motion_threshold = g_value_get_double(value);
+        break;
     case PROP_RESHAPE:
         base_inference->reshape = g_value_get_boolean(value);
         break;
@@ -398,6 +467,9 @@ void gva_base_inference_set_property(GObject *object, guint property_id, const G
     case PROP_NIREQ:
         base_inference->nireq = g_value_get_uint(value);
         break;
+    case PROP_NIREQ_MAX:
+        base_inference->nireq_max = g_value_get_uint(value);
+        break;
     case PROP_MODEL_INSTANCE_ID:
         g_free(base_inference->model_instance_id);
         base_inference->model_instance_id = g_value_dup_string(value);
@@ -420,6 +492,9 @@ void gva_base_inference_set_property(GObject *object, guint property_id, const G
         g_free(base_inference->device_extensions);
         base_inference->device_extensions = g_value_dup_string(value);
         break;
+    case PROP_WARM_UP:
+        base_inference->warm_up = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -444,6 +519,17 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_INFERENCE_INTERVAL:
         g_value_set_uint(value, base_inference->inference_interval);
         break;
+    case PROP_ADAPTIVE_INTERVAL:
+        g_value_set_boolean(value, base_inference->adaptive_interval);
+        break;
+    case PROP_MOTION_THRESHOLD:
+        g_value_set_double(value, base_inference->motion_threshold);
+        break;
+    case PROP_INFERENCE_RATE:
+        GST_OBJECT_LOCK(base_inference);
+        g_value_set_double(value, base_inference->inference_rate);
+        GST_OBJECT_UNLOCK(base_inference);
+        break;
     case PROP_RESHAPE:
         g_value_set_boolean(value, base_inference->reshape);
         break;
@@ -462,6 +548,9 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_NIREQ:
         g_value_set_uint(value, base_inference->nireq);
         break;
+    case PROP_NIREQ_MAX:
+        g_value_set_uint(value, base_inference->nireq_max);
+        break;
     case PROP_MODEL_INSTANCE_ID:
         g_value_set_string(value, base_inference->model_instance_id);
         break;
@@ -480,6 +569,9 @@ void gva_base_inference_get_property(GObject *object, guint property_id, GValue
     case PROP_DEVICE_EXTENSIONS:
         g_value_set_string(value, base_inference->device_extensions);
         break;
+    case PROP_WARM_UP:
+        g_value_set_boolean(value, base_inference->warm_up);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -34,12 +34,18 @@ typedef struct _GvaBaseInference {
     gchar *model_proc;
     gchar *device;
     guint inference_interval;
+    gboolean adaptive_interval;
+    gdouble motion_threshold;
+    guint tile_columns;
+    guint tile_rows;
+    gdouble tile_overlap;
     gboolean reshape;
     guint batch_size;
     guint reshape_width;
     guint reshape_height;
     gboolean no_block;
     guint nireq;
+    guint nireq_max;
     gchar *model_instance_id;
     guint cpu_streams;
     guint gpu_streams;
@@ -47,6 +53,7 @@ typedef struct _GvaBaseInference {
     gchar *allocator_name;
     gchar *pre_proc_name;
     gchar *device_extensions;
+    gboolean warm_up;
 
     // other fields
     GstVideoInfo *info;
@@ -61,6 +68,7 @@ typedef struct _GvaBaseInference {
 
     gboolean initialized;
     guint num_skipped_frames;
+    gdouble inference_rate; // guarded by object lock
 } GvaBaseInference;
 
 typedef struct _GvaBaseInferenceClass {
@@ -18,15 +18,19 @@
 #include "inference_backend/safe_arithmetic.h"
 #include "logger_functions.h"
 #include "model_proc/model_proc_provider.h"
+#include "pool_allocator.h"
 #include "runtime_feature_toggler.h"
 #include "utils.h"
 #include "video_frame.h"
 
 #include <gst/allocators/allocators.h>
 
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <cstring>
 #include <exception>
+#include <future>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -113,6 +117,7 @@ CreateNestedConfig(const GvaBaseInference *gva_base_inference) {
     std::map<std::string, std::string> inference = StringToMap(gva_base_inference->ie_config);
 
     base[KEY_NIREQ] = std::to_string(gva_base_inference->nireq);
+    base[KEY_NIREQ_MAX] = std::to_string(gva_base_inference->nireq_max);
     if (gva_base_inference->device != nullptr) {
         std::string device = gva_base_inference->device;
         base[KEY_DEVICE] = device;
@@ -178,6 +183,37 @@ void UpdateConfigWithLayerInfo(const std::vector<ModelInputProcessorInfo::Ptr> &
     config[KEY_FORMAT] = format;
 }
 
+// Splits [0, size) into 'parts' equal ranges, adjacent ranges overlap by 'overlap' fraction of range size
+void SplitWithOverlap(guint size, guint parts, double overlap, std::vector<std::pair<guint, guint>> &ranges) {
+    ranges.clear();
+    const double length = size / (1 + (parts - 1) * (1 - overlap));
+    for (guint i = 0; i < parts; i++) {
+        const guint start = parts > 1 ? static_cast<guint>(i * (size - length) / (parts - 1) + 0.5) : 0;
+        const guint end = i + 1 == parts ? size : std::min(size, static_cast<guint>(start + length + 0.5));
+        ranges.emplace_back(start, end - start);
+    }
+}
+
+std::vector<GstVideoRegionOfInterestMeta> MakeTiles(guint width, guint height, guint columns, guint rows,
+                                                    double overlap) {
+    std::vector<std::pair<guint, guint>> horizontal, vertical;
+    SplitWithOverlap(width, columns, overlap, horizontal);
+    SplitWithOverlap(height, rows, overlap, vertical);
+    std::vector<GstVideoRegionOfInterestMeta> tiles;
+    tiles.reserve(columns * rows);
+    for (const auto &row : vertical) {
+        for (const auto &column : horizontal) {
+            GstVideoRegionOfInterestMeta tile = GstVideoRegionOfInterestMeta();
+            tile.x = column.first;
+            tile.y = row.first;
+            tile.w = column.second;
+            tile.h = row.second;
+            tiles.push_back(tile);
+        }
+    }
+    return tiles;
+}
+
 void ApplyImageBoundaries(std::shared_ptr<InferenceBackend::Image> &image, const GstVideoRegionOfInterestMeta *meta) {
     // TODO: this is also implemented in VideoFrame::clip_normalized_rect, get rid of duplicate
     // workaround for cases when tinyyolov2 output blob parsing result coordinates are out of image
@@ -191,23 +227,28 @@ void ApplyImageBoundaries(std::shared_ptr<InferenceBackend::Image> &image, const
                    .height = (safe_add(meta->y, meta->h) > image->height) ? (image->height - meta->y) : meta->h};
 }
 
+// Image and its map context in one pooled allocation, unmapped when last reference is released
+struct MappedImage {
+    InferenceBackend::Image image;
+    BufferMapContext map_context;
+    GstBuffer *buffer;
+
+    MappedImage(GstBuffer *buffer) : image(), map_context(), buffer(buffer) {
+        map_context.frame.buffer = nullptr;
+    }
+    ~MappedImage() {
+        gva_buffer_unmap(buffer, image, map_context);
+    }
+};
+
 std::shared_ptr<InferenceBackend::Image> CreateImage(GstBuffer *buffer, GstVideoInfo *info,
                                                      InferenceBackend::MemoryType mem_type, GstMapFlags map_flags) {
     ITT_TASK(__FUNCTION__);
     try {
-        std::unique_ptr<InferenceBackend::Image> unique_image = std::unique_ptr<InferenceBackend::Image>(new Image);
-        assert(unique_image.get() != nullptr);
-
-        std::shared_ptr<BufferMapContext> map_context = std::make_shared<BufferMapContext>();
-        assert(map_context.get() != nullptr);
-
-        gva_buffer_map(buffer, *unique_image, *map_context, info, mem_type, map_flags);
-
-        auto image_deleter = [buffer, map_context](InferenceBackend::Image *image) {
-            gva_buffer_unmap(buffer, *image, *map_context);
-            delete image;
-        };
-        return std::shared_ptr<InferenceBackend::Image>(unique_image.release(), image_deleter);
+        auto mapped_image = std::allocate_shared<MappedImage>(Utils::PoolAllocator<MappedImage>(), buffer);
+        gva_buffer_map(buffer, mapped_image->image, mapped_image->map_context, info, mem_type, map_flags);
+        // aliasing constructor: Image pointer shares ownership of whole MappedImage
+        return std::shared_ptr<InferenceBackend::Image>(mapped_image, &mapped_image->image);
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error("Failed to create image from GstBuffer"));
     }
@@ -221,6 +262,18 @@ void UpdateClassificationHistory(GstVideoRegionOfInterestMeta *meta, GvaBaseInfe
     if (gvaclassify->reclassify_interval != 1 and meta_id > 0)
         gvaclassify->classification_history->UpdateROIParams(meta_id, classification_result);
 }
+
+// Results waiting for post-processing hold blobs and frames, queue is bounded by number of inference requests so that
+// slow post-processing throttles inference the same way as when it ran in completion callback
+size_t PostProcQueueSize(const GvaBaseInference *gva_base_inference) {
+    // with nireq=0 number of requests is chosen by inference device, typical optimal value is used
+    constexpr size_t DEFAULT_QUEUE_SIZE = 4;
+    if (!gva_base_inference)
+        return DEFAULT_QUEUE_SIZE;
+    const size_t nireq = std::max(gva_base_inference->nireq, gva_base_inference->nireq_max);
+    return nireq ? nireq : DEFAULT_QUEUE_SIZE;
+}
+
 } // namespace
 
 InferenceImpl::Model InferenceImpl::CreateModel(GvaBaseInference *gva_base_inference,
@@ -236,6 +289,11 @@ InferenceImpl::Model InferenceImpl::CreateModel(GvaBaseInference *gva_base_infer
                        gva_base_inference->nireq);
     set_log_function(GST_logger);
     std::map<std::string, std::map<std::string, std::string>> ie_config = CreateNestedConfig(gva_base_inference);
+    auto elapsed_ms = [](std::chrono::steady_clock::time_point start) {
+        return static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    };
+    const auto model_proc_start = std::chrono::steady_clock::now();
 
     Model model;
     if (!model_proc_path.empty()) {
@@ -256,6 +314,8 @@ InferenceImpl::Model InferenceImpl::CreateModel(GvaBaseInference *gva_base_infer
         }
     }
     UpdateConfigWithLayerInfo(model.input_processor_info, model.output_processor_info, ie_config);
+    const long model_proc_ms = elapsed_ms(model_proc_start);
+    const auto network_start = std::chrono::steady_clock::now();
     auto image_inference =
         ImageInference::make_shared(MemoryType::ANY, model_file, ie_config, allocator.get(),
                                     std::bind(&InferenceImpl::InferenceCompletionCallback, this, _1, _2),
@@ -264,11 +324,14 @@ InferenceImpl::Model InferenceImpl::CreateModel(GvaBaseInference *gva_base_infer
         throw std::runtime_error("Failed to create inference instance");
     model.inference = image_inference;
     model.name = image_inference->GetModelName();
+    GST_INFO_OBJECT(gva_base_inference, "Model '%s' loaded: model-proc %ld ms, network and infer requests %ld ms",
+                    model_file.c_str(), model_proc_ms, elapsed_ms(network_start));
 
     return model;
 }
 
-InferenceImpl::InferenceImpl(GvaBaseInference *gva_base_inference) : frame_num(0) {
+InferenceImpl::InferenceImpl(GvaBaseInference *gva_base_inference)
+    : frame_num(0), next_sequence_id(0), post_proc_worker(PostProcQueueSize(gva_base_inference)) {
     assert(gva_base_inference != nullptr);
 
     feature_toggler = std::unique_ptr<FeatureToggling::Runtime::RuntimeFeatureToggler>(
@@ -287,20 +350,89 @@ InferenceImpl::InferenceImpl(GvaBaseInference *gva_base_inference) : frame_num(0
 
     allocator = CreateAllocator(gva_base_inference->allocator_name);
 
+    // Models are independent, so they are read and compiled concurrently. Results are collected in the order of
+    // 'model' property, and the first error is rethrown after all loading threads finished and models loaded
+    // successfully are released, as destructor is not called if constructor throws
+    const auto load_start = std::chrono::steady_clock::now();
+    std::vector<std::future<Model>> loading_models;
     for (size_t i = 0; i < model_files.size(); i++) {
         std::string model_proc = i < model_procs.size() ? model_procs[i] : std::string();
-        Model model = CreateModel(gva_base_inference, allocator, model_files[i], model_proc);
-        this->models.push_back(std::move(model));
+        std::launch policy = model_files.size() > 1 ? std::launch::async : std::launch::deferred;
+        loading_models.push_back(std::async(policy, [this, gva_base_inference, i, &model_files, model_proc]() {
+            return CreateModel(gva_base_inference, allocator, model_files[i], model_proc);
+        }));
+    }
+    std::exception_ptr loading_error;
+    for (auto &loading_model : loading_models) {
+        try {
+            this->models.push_back(loading_model.get());
+        } catch (...) {
+            if (!loading_error)
+                loading_error = std::current_exception();
+        }
+    }
+    if (loading_error) {
+        ReleaseModels();
+        std::rethrow_exception(loading_error);
+    }
+    GST_INFO_OBJECT(
+        gva_base_inference, "%zu model(s) loaded in %ld ms", models.size(),
+        static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - load_start)
+                .count()));
+
+    if (gva_base_inference->warm_up)
+        WarmUp(gva_base_inference);
+}
+
+void InferenceImpl::WarmUp(GvaBaseInference *gva_base_inference) {
+    ITT_TASK(__FUNCTION__);
+    if (!gva_base_inference->info)
+        throw std::runtime_error("Can't warm up inference: video info is not set");
+    const auto start = std::chrono::steady_clock::now();
+
+    // black frame of negotiated format goes through the same mapping and pre-processing as real frames
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, GST_VIDEO_INFO_SIZE(gva_base_inference->info), nullptr);
+    if (!buffer)
+        throw std::runtime_error("Failed to allocate buffer for warm-up");
+    gst_buffer_memset(buffer, 0, 0, gst_buffer_get_size(buffer));
+    try {
+        std::shared_ptr<InferenceBackend::Image> image =
+            CreateImage(buffer, gva_base_inference->info, InferenceBackend::MemoryType::SYSTEM, GST_MAP_READ);
+        image->rect = {.x = 0, .y = 0, .width = image->width, .height = image->height};
+        for (Model &model : models)
+            model.inference->WarmUp(*image);
+    } catch (const std::exception &e) {
+        gst_buffer_unref(buffer);
+        std::throw_with_nested(std::runtime_error("Failed to warm up inference"));
     }
+    gst_buffer_unref(buffer);
+
+    GST_INFO_OBJECT(gva_base_inference, "Warm-up finished in %ld ms",
+                    static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now() - start)
+                                          .count()));
 }
 
 void InferenceImpl::FlushInference() {
     for (Model &model : models) {
         model.inference->Flush();
     }
+    post_proc_worker.Drain();
 }
 
 InferenceImpl::~InferenceImpl() {
+    // results of in-flight requests refer to models, so process them before models are destroyed
+    FlushInference();
+    post_proc_worker.Stop();
+    const std::string pool_stats =
+        "Pooled allocations: heap=" + std::to_string(Utils::GetPoolStats().heap_allocations.load()) +
+        ", reused=" + std::to_string(Utils::GetPoolStats().reused.load());
+    GVA_INFO(pool_stats.c_str());
+    ReleaseModels();
+}
+
+void InferenceImpl::ReleaseModels() {
     for (Model &model : models) {
         for (auto proc : model.output_processor_info)
             gst_structure_free(proc.second);
@@ -312,6 +444,17 @@ InferenceImpl::~InferenceImpl() {
     models.clear();
 }
 
+InferenceImpl::OutputFrame *InferenceImpl::FindOutputFrame(uint64_t sequence_id) {
+    if (output_frames.empty() || sequence_id < output_frames.front().sequence_id)
+        return nullptr;
+    const uint64_t index = sequence_id - output_frames.front().sequence_id;
+    if (index >= output_frames.size())
+        return nullptr;
+    OutputFrame &output_frame = output_frames[index];
+    assert(output_frame.sequence_id == sequence_id);
+    return &output_frame;
+}
+
 void InferenceImpl::PushOutput() {
     ITT_TASK(__FUNCTION__);
     while (!output_frames.empty()) {
@@ -326,6 +469,14 @@ void InferenceImpl::PushOutput() {
                 UpdateClassificationHistory(&inference_roi->roi, front.filter, roi_classification);
             }
         }
+        if (front.filter->post_proc && !front.inference_rois.empty())
+            front.filter->post_proc->finalize_frame(front.writable_buffer ? front.writable_buffer : front.buffer,
+                                                    front.filter);
+        if (front.adaptive_interval && !front.inference_rois.empty()) {
+            GstBuffer *buffer = front.writable_buffer ? front.writable_buffer : front.buffer;
+            front.adaptive_interval->SetObjectsCount(
+                gst_buffer_get_n_meta(buffer, GST_VIDEO_REGION_OF_INTEREST_META_API_TYPE));
+        }
 
         PushBufferToSrcPad(front);
         output_frames.pop_front();
@@ -333,6 +484,15 @@ void InferenceImpl::PushOutput() {
 }
 
 void InferenceImpl::PushBufferToSrcPad(OutputFrame &output_frame) {
+    if (output_frame.filter->is_full_frame) {
+        // mark is set on writable buffer only, so it is not seen by other owners of shared buffer (e.g. other tee
+        // branch). Buffer of skipped frame has no writable version yet, it gets one sharing frame data
+        if (!output_frame.writable_buffer && output_frame.inference_skipped) {
+            output_frame.writable_buffer = gst_buffer_make_writable(output_frame.buffer);
+        }
+        if (output_frame.writable_buffer)
+            gva_buffer_set_inference_skipped(output_frame.writable_buffer, output_frame.inference_skipped);
+    }
     GstBuffer *buffer = output_frame.writable_buffer ? output_frame.writable_buffer : output_frame.buffer;
 
     if (!check_gva_base_inference_stopped(output_frame.filter)) {
@@ -344,32 +504,42 @@ void InferenceImpl::PushBufferToSrcPad(OutputFrame &output_frame) {
     }
 }
 
+std::shared_ptr<GstVideoInfo> InferenceImpl::GetSharedVideoInfo(GvaBaseInference *gva_base_inference) {
+    if (!gva_base_inference->info)
+        return nullptr;
+    // copy only when caps changed, in-flight frames keep previous snapshot
+    std::shared_ptr<GstVideoInfo> &video_info = video_infos[gva_base_inference];
+    if (!video_info || !gst_video_info_is_equal(video_info.get(), gva_base_inference->info))
+        video_info = InferenceFrame::MakeSharedVideoInfo(gva_base_inference->info);
+    return video_info;
+}
+
 std::shared_ptr<InferenceImpl::InferenceResult>
 InferenceImpl::MakeInferenceResult(GvaBaseInference *gva_base_inference, Model &model,
                                    GstVideoRegionOfInterestMeta *meta, std::shared_ptr<InferenceBackend::Image> &image,
-                                   GstBuffer *buffer) {
-    auto result = std::make_shared<InferenceResult>();
-    assert(result.get() != nullptr); // expect that std::make_shared must throw instead of returning nullptr
-
-    result->inference_frame = std::make_shared<InferenceFrame>();
-    assert(result->inference_frame.get() !=
-           nullptr); // expect that std::make_shared must throw instead of returning nullptr
+                                   const std::shared_ptr<GstVideoInfo> &video_info, GstBuffer *buffer,
+                                   uint64_t sequence_id) {
+    // pooled: result and frame are created per ROI and released on another thread
+    auto result = std::allocate_shared<InferenceResult>(Utils::PoolAllocator<InferenceResult>());
+    result->inference_frame = std::allocate_shared<InferenceFrame>(Utils::PoolAllocator<InferenceFrame>());
 
     result->inference_frame->buffer = buffer;
     result->inference_frame->roi = *meta;
     result->inference_frame->gva_base_inference = gva_base_inference;
-    if (gva_base_inference->info)
-        result->inference_frame->info = gst_video_info_copy(gva_base_inference->info);
+    result->inference_frame->setVideoInfo(video_info);
 
     result->model = &model;
     result->image = image;
+    result->sequence_id = sequence_id;
+    result->roi_index = 0;
     return result;
 }
 
 GstFlowReturn InferenceImpl::SubmitImages(GvaBaseInference *gva_base_inference,
                                           const std::vector<GstVideoRegionOfInterestMeta *> &metas, GstVideoInfo *info,
-                                          GstBuffer *buffer) {
+                                          GstBuffer *buffer, uint64_t sequence_id) {
     ITT_TASK(__FUNCTION__);
+    LATENCY_TRACE_SCOPE("inference-submit", GST_BUFFER_PTS(buffer));
     InferenceBackend::MemoryType mem_type = InferenceBackend::MemoryType::SYSTEM;
     try {
         if (std::string(gva_base_inference->pre_proc_name) == "vaapi") {
@@ -384,11 +554,15 @@ GstFlowReturn InferenceImpl::SubmitImages(GvaBaseInference *gva_base_inference,
 #endif
         }
         std::shared_ptr<InferenceBackend::Image> image = CreateImage(buffer, info, mem_type, GST_MAP_READ);
+        const std::shared_ptr<GstVideoInfo> video_info = GetSharedVideoInfo(gva_base_inference);
 
         for (InferenceImpl::Model &model : models) {
-            for (const auto meta : metas) {
+            for (size_t i = 0; i < metas.size(); i++) {
+                GstVideoRegionOfInterestMeta *meta = metas[i];
                 ApplyImageBoundaries(image, meta);
-                auto result = MakeInferenceResult(gva_base_inference, model, meta, image, buffer);
+                auto result =
+                    MakeInferenceResult(gva_base_inference, model, meta, image, video_info, buffer, sequence_id);
+                result->roi_index = i;
                 std::map<std::string, InferenceBackend::InputLayerDesc::Ptr> input_preprocessors;
                 if (not model.input_processor_info.empty() and gva_base_inference->input_prerocessors_factory)
                     input_preprocessors = gva_base_inference->input_prerocessors_factory(
@@ -408,6 +582,46 @@ const std::vector<InferenceImpl::Model> &InferenceImpl::GetModels() const {
     return models;
 }
 
+InferenceImpl::InferenceStatus InferenceImpl::CheckSkip(GvaBaseInference *gva_base_inference, GstBuffer *buffer,
+                                                       GstVideoInfo *info, AdaptiveInterval *&adaptive_interval) {
+    ITT_TASK("InferenceImpl::TransformFrameIp check_skip");
+    InferenceStatus status = INFERENCE_EXECUTED;
+    if (gva_base_inference->adaptive_interval && gva_base_inference->is_full_frame) {
+        std::unique_ptr<AdaptiveInterval> &state = adaptive_intervals[gva_base_inference];
+        if (!state)
+            state.reset(new AdaptiveInterval());
+        adaptive_interval = state.get();
+        if (!adaptive_interval->IsInferenceNeeded(buffer, info, gva_base_inference->inference_interval,
+                                                  gva_base_inference->motion_threshold))
+            status = INFERENCE_SKIPPED_PER_PROPERTY;
+    } else if (++gva_base_inference->num_skipped_frames < gva_base_inference->inference_interval) {
+        status = INFERENCE_SKIPPED_PER_PROPERTY;
+    }
+    if (gva_base_inference->no_block) {
+        for (auto model : models) {
+            if (model.inference->IsQueueFull()) {
+                status = INFERENCE_SKIPPED_NO_BLOCK;
+                break;
+            }
+        }
+    }
+    if (status == INFERENCE_EXECUTED) {
+        gva_base_inference->num_skipped_frames = 0;
+        if (adaptive_interval) {
+            adaptive_interval->OnInferenceSubmitted(gva_base_inference->inference_interval);
+            GST_LOG_OBJECT(gva_base_inference, "Motion score %.2f, next inference interval %u",
+                           adaptive_interval->GetMotionScore(), adaptive_interval->GetInterval());
+        }
+    }
+
+    // exponential moving average with weight 1/32 of the last frame
+    const gdouble executed = status == INFERENCE_EXECUTED ? 1. : 0.;
+    GST_OBJECT_LOCK(gva_base_inference);
+    gva_base_inference->inference_rate += (executed - gva_base_inference->inference_rate) / 32;
+    GST_OBJECT_UNLOCK(gva_base_inference);
+    return status;
+}
+
 GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inference, GstBuffer *buffer,
                                               GstVideoInfo *info) {
     ITT_TASK(__FUNCTION__);
@@ -415,37 +629,29 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
 
     assert(gva_base_inference != nullptr);
 
-    InferenceStatus status = INFERENCE_EXECUTED;
-    {
-        ITT_TASK("InferenceImpl::TransformFrameIp check_skip");
-        if (++gva_base_inference->num_skipped_frames < gva_base_inference->inference_interval) {
-            status = INFERENCE_SKIPPED_PER_PROPERTY;
-        }
-        if (gva_base_inference->no_block) {
-            for (auto model : models) {
-                if (model.inference->IsQueueFull()) {
-                    status = INFERENCE_SKIPPED_NO_BLOCK;
-                    break;
-                }
-            }
-        }
-        if (status == INFERENCE_EXECUTED) {
-            gva_base_inference->num_skipped_frames = 0;
-        }
-    }
+    AdaptiveInterval *adaptive_interval = nullptr;
+    InferenceStatus status = CheckSkip(gva_base_inference, buffer, info, adaptive_interval);
 
     // Collect all ROI metas into std::vector
     std::vector<GstVideoRegionOfInterestMeta *> metas;
     GstVideoRegionOfInterestMeta full_frame_meta;
+    std::vector<GstVideoRegionOfInterestMeta> tiles;
     {
         ITT_TASK("InferenceImpl::TransformFrameIp collect_meta");
         if (gva_base_inference->is_full_frame) {
-            full_frame_meta = GstVideoRegionOfInterestMeta();
-            full_frame_meta.x = 0;
-            full_frame_meta.y = 0;
-            full_frame_meta.w = info->width;
-            full_frame_meta.h = info->height;
-            metas.push_back(&full_frame_meta);
+            if (gva_base_inference->tile_columns * gva_base_inference->tile_rows > 1) {
+                tiles = MakeTiles(info->width, info->height, gva_base_inference->tile_columns,
+                                  gva_base_inference->tile_rows, gva_base_inference->tile_overlap);
+                for (GstVideoRegionOfInterestMeta &tile : tiles)
+                    metas.push_back(&tile);
+            } else {
+                full_frame_meta = GstVideoRegionOfInterestMeta();
+                full_frame_meta.x = 0;
+                full_frame_meta.y = 0;
+                full_frame_meta.w = info->width;
+                full_frame_meta.h = info->height;
+                metas.push_back(&full_frame_meta);
+            }
         } else {
             GstVideoRegionOfInterestMeta *meta = NULL;
             gpointer state = NULL;
@@ -463,21 +669,30 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
     frame_num++;
 
     // push into output_frames queue
+    uint64_t sequence_id;
     {
         ITT_TASK("InferenceImpl::TransformFrameIp pushIntoOutputFramesQueue");
         std::lock_guard<std::mutex> guard(output_frames_mutex);
         if (!inference_count && output_frames.empty()) {
-            // If we don't need to run inference and there are no frames queued for inference then finish transform
+            // If we don't need to run inference and there are no frames queued for inference then finish transform.
+            // Buffer shared with other elements (e.g. other tee branch) is passed as is and is not marked, as mark
+            // would be seen by them too
+            if (gva_base_inference->is_full_frame && gst_buffer_is_writable(buffer))
+                gva_buffer_set_inference_skipped(buffer, status != INFERENCE_EXECUTED);
             return GST_FLOW_OK;
         }
 
         // increment buffer reference
         buffer = gst_buffer_ref(buffer);
+        sequence_id = next_sequence_id++;
         InferenceImpl::OutputFrame output_frame = {.buffer = buffer,
                                                    .writable_buffer = NULL,
                                                    .inference_count = inference_count,
                                                    .filter = gva_base_inference,
-                                                   .inference_rois = {}};
+                                                   .inference_rois = {},
+                                                   .sequence_id = sequence_id,
+                                                   .adaptive_interval = adaptive_interval,
+                                                   .inference_skipped = status != INFERENCE_EXECUTED};
         output_frames.push_back(output_frame);
 
         if (!inference_count) {
@@ -485,40 +700,55 @@ GstFlowReturn InferenceImpl::TransformFrameIp(GvaBaseInference *gva_base_inferen
         }
     }
 
-    return SubmitImages(gva_base_inference, metas, info, buffer);
+    return SubmitImages(gva_base_inference, metas, info, buffer, sequence_id);
 }
 
 void InferenceImpl::SinkEvent(GstEvent *event) {
     if (event->type == GST_EVENT_EOS) {
-        for (Model &model : models) {
-            model.inference->Flush();
-        }
+        // all buffers must be pushed before EOS goes downstream
+        FlushInference();
     }
 }
 
 void InferenceImpl::PushFramesIfInferenceFailed(
     std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames) {
+    post_proc_worker.Submit([this, frames]() { ProcessFailedFrames(frames); });
+}
+
+void InferenceImpl::InferenceCompletionCallback(
+    std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs,
+    std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames) {
+    ITT_TASK(__FUNCTION__);
+    if (frames.empty())
+        return;
+    // blobs are owned copies (see OpenVINOImageInference::WorkingFunction), infer request is reused after return
+    post_proc_worker.Submit([this, blobs, frames]() { ProcessInferenceResults(blobs, frames); });
+}
+
+void InferenceImpl::ProcessFailedFrames(
+    const std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> &frames) {
+    std::lock_guard<std::mutex> guard(output_frames_mutex);
     for (auto &frame : frames) {
         auto inference_result = std::dynamic_pointer_cast<InferenceResult>(frame);
         assert(inference_result.get() != nullptr); // InferenceResult is inherited from IFrameBase
+        inference_result->image = nullptr;
 
-        std::shared_ptr<InferenceFrame> inference_roi = inference_result->inference_frame;
-        auto it =
-            std::find_if(output_frames.begin(), output_frames.end(), [inference_roi](const OutputFrame &output_frame) {
-                return output_frame.buffer == inference_roi->buffer;
-            });
-        PushBufferToSrcPad(*it);
-        output_frames.erase(it);
+        // frame is pushed without inference results, in order with other frames, once all its ROIs are done
+        OutputFrame *output_frame = FindOutputFrame(inference_result->sequence_id);
+        if (output_frame == nullptr) {
+            GVA_ERROR("Output frame for failed inference request is not found");
+            continue;
+        }
+        --output_frame->inference_count;
     }
+    PushOutput();
 }
 
-void InferenceImpl::InferenceCompletionCallback(
-    std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs,
-    std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames) {
+void InferenceImpl::ProcessInferenceResults(
+    const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &blobs,
+    const std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> &frames) {
     std::lock_guard<std::mutex> guard(output_frames_mutex);
     ITT_TASK(__FUNCTION__);
-    if (frames.empty())
-        return;
 
     std::vector<std::shared_ptr<InferenceFrame>> inference_frames;
     PostProcessor *post_proc = nullptr;
@@ -536,37 +766,38 @@ void InferenceImpl::InferenceCompletionCallback(
         else
             assert(post_proc == inference_roi->gva_base_inference->post_proc);
 
-        for (auto &output_frame : output_frames) {
-            if (output_frame.buffer == inference_roi->buffer) {
-                if (output_frame.filter->is_full_frame) { // except gvaclassify because it doesn't attach new metadata
-                    if (output_frame.inference_count == 0)
-                        // This condition is necessary if two items in output_frames refer to the same buffer.
-                        // If current output_frame.inference_count equals 0, then inference for this output_frame
-                        // already happened, but buffer wasn't pushed further by pipeline yet. We skip this buffer
-                        // to find another, to which current inference callback really belongs
-                        continue;
-                    if (output_frame.writable_buffer) {
-                        // check if we have writable version of this buffer (this function called multiple times
-                        // on same buffer)
-                        inference_roi->buffer = output_frame.writable_buffer;
-                    } else {
-                        if (!gst_buffer_is_writable(inference_roi->buffer)) {
-                            GST_WARNING_OBJECT(output_frame.filter, "Making a writable buffer requires buffer copy");
-                            inference_roi->buffer = gst_buffer_make_writable(inference_roi->buffer);
-                        }
-                        output_frame.writable_buffer = inference_roi->buffer;
-                    }
+        OutputFrame *output_frame = FindOutputFrame(inference_result->sequence_id);
+        if (output_frame == nullptr) {
+            GVA_ERROR("Output frame for completed inference request is not found");
+            continue;
+        }
+        if (output_frame->filter->is_full_frame) { // except gvaclassify because it doesn't attach new metadata
+            if (output_frame->writable_buffer) {
+                // check if we have writable version of this buffer (this function called multiple times
+                // on same buffer)
+                inference_roi->buffer = output_frame->writable_buffer;
+            } else {
+                if (!gst_buffer_is_writable(inference_roi->buffer)) {
+                    GST_DEBUG_OBJECT(output_frame->filter,
+                                     "Making a writable buffer copies metadata, frame memory is shared");
+                    inference_roi->buffer = gst_buffer_make_writable(inference_roi->buffer);
                 }
-                output_frame.inference_rois.push_back(inference_roi);
-                --output_frame.inference_count;
-                break;
+                output_frame->writable_buffer = inference_roi->buffer;
             }
         }
+        output_frame->inference_rois.push_back(inference_roi);
+        --output_frame->inference_count;
         inference_frames.push_back(inference_roi);
     }
 
-    if (post_proc != nullptr) {
-        post_proc->process(blobs, inference_frames);
+    if (post_proc != nullptr && !inference_frames.empty()) {
+        LATENCY_TRACE_SCOPE("post-processing", GST_BUFFER_PTS(inference_frames.front()->buffer));
+        try {
+            post_proc->process(blobs, inference_frames);
+        } catch (const std::exception &e) {
+            // frames are pushed without results of this request, as if inference failed
+            GVA_ERROR(Utils::createNestedErrorMsg(e).c_str());
+        }
     }
 
     PushOutput();
@@ -7,17 +7,19 @@
 #ifndef __BASE_INFERENCE_H__
 #define __BASE_INFERENCE_H__
 
+#include "adaptive_interval.h"
 #include "classification_history.h"
 #include "common/input_model_preproc.h"
 #include "gstgvaclassify.h"
 #include "gva_base_inference.h"
+#include "ordered_worker.h"
 
 #include "feature_toggling/ifeature_toggler.h"
 #include "inference_backend/image_inference.h"
 
 #include <gst/video/video.h>
 
-#include <list>
+#include <deque>
 #include <memory>
 #include <mutex>
 
@@ -45,6 +47,17 @@ class InferenceImpl {
         std::shared_ptr<InferenceFrame> inference_frame;
         Model *model;
         std::shared_ptr<InferenceBackend::Image> image;
+        uint64_t sequence_id; // id of OutputFrame this result belongs to
+        uint64_t roi_index;   // position of ROI among ROIs of the buffer submitted to the model
+
+        uint64_t GetTimestamp() const override {
+            if (!inference_frame || !inference_frame->buffer)
+                return InferenceBackend::ImageInference::NO_TIMESTAMP;
+            return GST_BUFFER_PTS(inference_frame->buffer);
+        }
+        uint64_t GetIndex() const override {
+            return roi_index;
+        }
     };
 
     enum InferenceStatus {
@@ -59,6 +72,10 @@ class InferenceImpl {
     std::vector<Model> models;
     std::shared_ptr<InferenceBackend::Allocator> allocator;
     std::unique_ptr<FeatureToggling::Base::IFeatureToggler> feature_toggler;
+    // per element snapshot of negotiated video info shared by all in-flight frames, guarded by _mutex
+    std::map<GvaBaseInference *, std::shared_ptr<GstVideoInfo>> video_infos;
+    // per element motion state for adaptive-interval, guarded by _mutex
+    std::map<GvaBaseInference *, std::unique_ptr<AdaptiveInterval>> adaptive_intervals;
 
     struct OutputFrame {
         GstBuffer *buffer;
@@ -66,26 +83,46 @@ class InferenceImpl {
         int inference_count;
         GvaBaseInference *filter;
         std::vector<std::shared_ptr<InferenceFrame>> inference_rois;
+        uint64_t sequence_id;
+        AdaptiveInterval *adaptive_interval; // receives number of detected objects, null if adaptive-interval is off
+        bool inference_skipped;              // full-frame inference was not run on this frame
     };
 
-    std::list<OutputFrame> output_frames;
+    // Frames are queued with consecutive sequence ids, so frame with given id is found at
+    // (id - front().sequence_id) position in O(1) instead of searching by buffer pointer
+    std::deque<OutputFrame> output_frames;
+    uint64_t next_sequence_id;
     std::mutex output_frames_mutex;
 
+    // Post-processing and pushing downstream run here, so inference completion callback returns infer request to
+    // the pool without waiting for post-processing and downstream elements
+    OrderedWorker post_proc_worker;
+
+    OutputFrame *FindOutputFrame(uint64_t sequence_id);
     void PushOutput();
     void PushBufferToSrcPad(OutputFrame &output_frame);
     void PushFramesIfInferenceFailed(std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames);
     void InferenceCompletionCallback(std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs,
                                      std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> frames);
+    void ProcessFailedFrames(const std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> &frames);
+    void ProcessInferenceResults(const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &blobs,
+                                 const std::vector<std::shared_ptr<InferenceBackend::ImageInference::IFrameBase>> &frames);
     Model CreateModel(GvaBaseInference *gva_base_inference, std::shared_ptr<InferenceBackend::Allocator> &allocator,
                       const std::string &model_file, const std::string &model_proc_path);
+    void ReleaseModels();
 
     GstFlowReturn SubmitImages(GvaBaseInference *gva_base_inference,
                                const std::vector<GstVideoRegionOfInterestMeta *> &metas, GstVideoInfo *info,
-                               GstBuffer *buffer);
+                               GstBuffer *buffer, uint64_t sequence_id);
     std::shared_ptr<InferenceResult> MakeInferenceResult(GvaBaseInference *gva_base_inference, Model &model,
                                                          GstVideoRegionOfInterestMeta *meta,
                                                          std::shared_ptr<InferenceBackend::Image> &image,
-                                                         GstBuffer *buffer);
+                                                         const std::shared_ptr<GstVideoInfo> &video_info,
+                                                         GstBuffer *buffer, uint64_t sequence_id);
+    std::shared_ptr<GstVideoInfo> GetSharedVideoInfo(GvaBaseInference *gva_base_inference);
+    void WarmUp(GvaBaseInference *gva_base_inference);
+    InferenceStatus CheckSkip(GvaBaseInference *gva_base_inference, GstBuffer *buffer, GstVideoInfo *info,
+                              AdaptiveInterval *&adaptive_interval);
 };
 
 #endif /* __BASE_INFERENCE_H__ */
@@ -75,10 +75,17 @@ void fillElementProps(GvaBaseInference *targetElem, GvaBaseInference *masterElem
     COPY_GSTRING(targetElem->model_proc, masterElem->model_proc);
     targetElem->batch_size = masterElem->batch_size;
     targetElem->inference_interval = masterElem->inference_interval;
+    targetElem->adaptive_interval = masterElem->adaptive_interval;
+    targetElem->motion_threshold = masterElem->motion_threshold;
+    targetElem->tile_columns = masterElem->tile_columns;
+    targetElem->tile_rows = masterElem->tile_rows;
+    targetElem->tile_overlap = masterElem->tile_overlap;
     targetElem->no_block = masterElem->no_block;
     targetElem->nireq = masterElem->nireq;
+    targetElem->nireq_max = masterElem->nireq_max;
     targetElem->cpu_streams = masterElem->cpu_streams;
     targetElem->gpu_streams = masterElem->gpu_streams;
+    targetElem->warm_up = masterElem->warm_up;
     COPY_GSTRING(targetElem->ie_config, masterElem->ie_config);
     COPY_GSTRING(targetElem->allocator_name, masterElem->allocator_name);
     COPY_GSTRING(targetElem->pre_proc_name, masterElem->pre_proc_name);
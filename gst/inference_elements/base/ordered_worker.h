@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/logger.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+// Executes submitted tasks one by one on a dedicated thread, in submission order. With non-zero capacity Submit
+// blocks while that many tasks are queued, so producers are throttled by the speed of the worker
+class OrderedWorker {
+  public:
+    explicit OrderedWorker(size_t capacity = 0) : capacity(capacity), stopped(false) {
+        thread = std::thread(&OrderedWorker::Run, this);
+    }
+
+    ~OrderedWorker() {
+        Stop();
+    }
+
+    OrderedWorker(const OrderedWorker &) = delete;
+    OrderedWorker &operator=(const OrderedWorker &) = delete;
+
+    void Submit(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // task may submit another one (e.g. buffer pushed to downstream element sharing the same inference
+            // instance), worker thread is never blocked to avoid waiting for itself
+            if (std::this_thread::get_id() != thread.get_id())
+                space_available.wait(lock, [this] { return stopped || !capacity || tasks.size() < capacity; });
+            if (!stopped) {
+                tasks.push(std::move(task));
+                condition.notify_one();
+                return;
+            }
+        }
+        // worker is stopped, execute on caller thread so that task is not lost
+        task();
+    }
+
+    // Blocks until all previously submitted tasks are executed. Must not be called from the worker thread
+    void Drain() {
+        std::promise<void> done;
+        std::future<void> future = done.get_future();
+        Submit([&done]() { done.set_value(); });
+        future.wait();
+    }
+
+    // Executes remaining tasks and joins worker thread
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopped)
+                return;
+            stopped = true;
+        }
+        condition.notify_one();
+        space_available.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+  private:
+    void Run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopped || !tasks.empty(); });
+            if (tasks.empty())
+                return; // stopped and drained
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop();
+            lock.unlock();
+            space_available.notify_one();
+            // exception must not escape worker thread, otherwise whole process is terminated
+            try {
+                task();
+            } catch (const std::exception &e) {
+                GVA_ERROR(("Task of ordered worker failed: " + std::string(e.what())).c_str());
+            } catch (...) {
+                GVA_ERROR("Task of ordered worker failed with unknown exception");
+            }
+        }
+    }
+
+    std::queue<std::function<void()>> tasks;
+    const size_t capacity;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable space_available;
+    bool stopped;
+    std::thread thread;
+};
@@ -15,6 +15,7 @@
 #include <gst/video/video.h>
 
 #include <functional>
+#include <memory>
 
 struct _GvaBaseInference;
 typedef struct _GvaBaseInference GvaBaseInference;
@@ -24,38 +25,41 @@ struct InferenceFrame {
     GstVideoRegionOfInterestMeta roi;
     std::vector<GstStructure *> roi_classifications; // length equals to output layers count
     GvaBaseInference *gva_base_inference;
-    GstVideoInfo *info;
+    GstVideoInfo *info; // points to video_info, valid while frame is alive
+    // Video info is immutable snapshot shared by all frames of the same caps instead of copy per ROI
+    std::shared_ptr<GstVideoInfo> video_info;
 
-    InferenceFrame() = default;
+    InferenceFrame() : buffer(nullptr), roi(), gva_base_inference(nullptr), info(nullptr) {
+    }
     InferenceFrame(GstBuffer *_buf, GstVideoRegionOfInterestMeta _roi, std::vector<GstStructure *> _roi_classifications,
                    GvaBaseInference *_gva_base_inference, GstVideoInfo *_info)
         : buffer(_buf), roi(_roi), roi_classifications(_roi_classifications), gva_base_inference(_gva_base_inference) {
-        info = (_info) ? gst_video_info_copy(_info) : nullptr;
+        setVideoInfo(MakeSharedVideoInfo(_info));
+    }
+
+    void setVideoInfo(const std::shared_ptr<GstVideoInfo> &_video_info) {
+        video_info = _video_info;
+        info = video_info.get();
     }
+
     InferenceFrame(const InferenceFrame &inf)
         : buffer(inf.buffer), roi(inf.roi), roi_classifications(inf.roi_classifications),
           gva_base_inference(inf.gva_base_inference) {
-        this->info = (inf.info) ? gst_video_info_copy(inf.info) : nullptr;
+        setVideoInfo(inf.video_info);
     }
     InferenceFrame &operator=(const InferenceFrame &rhs) {
         buffer = rhs.buffer;
         roi = rhs.roi;
         roi_classifications = rhs.roi_classifications;
         gva_base_inference = rhs.gva_base_inference;
-        if (this->info) {
-            gst_video_info_free(this->info);
-            this->info = nullptr;
-        }
-        if (rhs.info)
-            this->info = gst_video_info_copy(rhs.info);
-
+        setVideoInfo(rhs.video_info);
         return *this;
     }
-    ~InferenceFrame() {
-        if (info) {
-            gst_video_info_free(info);
-            info = nullptr;
-        }
+
+    static std::shared_ptr<GstVideoInfo> MakeSharedVideoInfo(const GstVideoInfo *_info) {
+        if (!_info)
+            return nullptr;
+        return std::shared_ptr<GstVideoInfo>(gst_video_info_copy(_info), gst_video_info_free);
     }
 };
 
@@ -10,5 +10,10 @@
 struct PostProcessor {
     virtual void process(const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &output_blobs,
                          std::vector<std::shared_ptr<InferenceFrame>> &frames) = 0;
+    // Called once per frame after results of all its regions were processed, before frame is pushed downstream
+    virtual void finalize_frame(GstBuffer *buffer, GvaBaseInference *gva_base_inference) {
+        (void)buffer;
+        (void)gva_base_inference;
+    }
     virtual ~PostProcessor() = default;
 };
@@ -162,7 +162,9 @@ void TensorToText(GVA::Tensor &classification_result, GValueArray * /*labels*/)
 
 using ConvertersMap = std::map<std::string, ConverterFunctionType>;
 
-ConverterFunctionType getConverter(GstStructure *model_proc_info) {
+} // anonymous namespace
+
+ConverterFunctionType ClassificationPlugin::getConverter(GstStructure *model_proc_info) {
     ITT_TASK(__FUNCTION__);
     if (model_proc_info == nullptr)
         throw std::invalid_argument("Model proc is empty");
@@ -190,6 +192,8 @@ ConverterFunctionType getConverter(GstStructure *model_proc_info) {
     return converter_it->second;
 }
 
+namespace {
+
 GstStructure *createResultStructure(OutputBlob::Ptr &blob, ClassificationLayerInfo &info, const std::string &model_name,
                                     const std::string &layer_name, size_t batch_size, size_t frame_index) {
     GstStructure *classification_result = copy(info.model_proc_info.get(), gst_structure_copy);
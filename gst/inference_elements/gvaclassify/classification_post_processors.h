@@ -19,6 +19,9 @@ namespace ClassificationPlugin {
 
 using ConverterFunctionType = std::function<void(GVA::Tensor &, GValueArray *)>;
 
+// Converter selected by 'converter' field of layer description in model-proc file
+ConverterFunctionType getConverter(GstStructure *model_proc_info);
+
 struct ClassificationLayerInfo {
     ConverterFunctionType converter;
     GValueArrayUniquePtr labels;
@@ -9,6 +9,7 @@
 #include "classification_history.h"
 #include "classification_post_processors_c.h"
 #include "pre_processors.h"
+#include "roi_filter.h"
 
 #include "config.h"
 
@@ -25,12 +26,19 @@ enum {
     PROP_0,
     PROP_OBJECT_CLASS,
     PROP_RECLASSIFY_INTERVAL,
+    PROP_ZONES,
+    PROP_MIN_OBJECT_SIZE,
+    PROP_MAX_OBJECT_SIZE,
+    PROP_SKIP_STATS,
 };
 
 #define DEFAULT_OBJECT_CLASS ""
 #define DEFAULT_RECLASSIFY_INTERVAL 1
 #define DEFAULT_MIN_RECLASSIFY_INTERVAL 0
 #define DEFAULT_MAX_RECLASSIFY_INTERVAL UINT_MAX
+#define DEFAULT_ZONES ""
+#define DEFAULT_MIN_OBJECT_SIZE 0
+#define DEFAULT_MAX_OBJECT_SIZE 0
 
 GST_DEBUG_CATEGORY_STATIC(gst_gva_classify_debug_category);
 #define GST_CAT_DEFAULT gst_gva_classify_debug_category
@@ -75,6 +83,17 @@ void gst_gva_classify_set_property(GObject *object, guint property_id, const GVa
         }
         break;
     }
+    case PROP_ZONES: {
+        g_free(gvaclassify->zones);
+        gvaclassify->zones = g_value_dup_string(value);
+        break;
+    }
+    case PROP_MIN_OBJECT_SIZE:
+        gvaclassify->min_object_size = g_value_get_uint(value);
+        break;
+    case PROP_MAX_OBJECT_SIZE:
+        gvaclassify->max_object_size = g_value_get_uint(value);
+        break;
     default: {
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -94,6 +113,18 @@ void gst_gva_classify_get_property(GObject *object, guint property_id, GValue *v
     case PROP_RECLASSIFY_INTERVAL:
         g_value_set_uint(value, gvaclassify->reclassify_interval);
         break;
+    case PROP_ZONES:
+        g_value_set_string(value, gvaclassify->zones);
+        break;
+    case PROP_MIN_OBJECT_SIZE:
+        g_value_set_uint(value, gvaclassify->min_object_size);
+        break;
+    case PROP_MAX_OBJECT_SIZE:
+        g_value_set_uint(value, gvaclassify->max_object_size);
+        break;
+    case PROP_SKIP_STATS:
+        g_value_take_string(value, roi_filter_get_stats(gvaclassify->roi_filter));
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -138,6 +169,33 @@ void gst_gva_classify_class_init(GstGvaClassifyClass *gvaclassify_class) {
             "inference interval)",
             DEFAULT_MIN_RECLASSIFY_INTERVAL, DEFAULT_MAX_RECLASSIFY_INTERVAL, DEFAULT_RECLASSIFY_INTERVAL,
             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_ZONES,
+        g_param_spec_string(
+            "zones", "Zones",
+            "Path to JSON file with polygon zones: {\"zones\": [{\"name\": \"tv\", \"type\": \"exclude\", "
+            "\"points\": [[x, y], ...]}]}. Coordinates are normalized to [0, 1]. Objects with center inside any "
+            "'exclude' zone, or outside all 'include' zones if there are any, are not classified",
+            DEFAULT_ZONES, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_MIN_OBJECT_SIZE,
+        g_param_spec_uint("min-object-size", "Min Object Size",
+                          "Objects with smaller side less than this value in pixels are not classified (0 - no limit)",
+                          0, UINT_MAX, DEFAULT_MIN_OBJECT_SIZE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_OBJECT_SIZE,
+        g_param_spec_uint("max-object-size", "Max Object Size",
+                          "Objects with larger side greater than this value in pixels are not classified "
+                          "(0 - no limit)",
+                          0, UINT_MAX, DEFAULT_MAX_OBJECT_SIZE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SKIP_STATS,
+        g_param_spec_string("skip-stats", "Skip Statistics",
+                            "Number of objects not classified because of 'min-object-size'/'max-object-size' (size), "
+                            "'include' zones (outside-zones) and each 'exclude' zone (by zone name)",
+                            "", (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
 }
 
 void gst_gva_classify_init(GstGvaClassify *gvaclassify) {
@@ -151,6 +209,12 @@ void gst_gva_classify_init(GstGvaClassify *gvaclassify) {
     gvaclassify->base_inference.is_full_frame = FALSE;
     gvaclassify->object_class = g_strdup(DEFAULT_OBJECT_CLASS);
     gvaclassify->reclassify_interval = DEFAULT_RECLASSIFY_INTERVAL;
+    gvaclassify->zones = g_strdup(DEFAULT_ZONES);
+    gvaclassify->min_object_size = DEFAULT_MIN_OBJECT_SIZE;
+    gvaclassify->max_object_size = DEFAULT_MAX_OBJECT_SIZE;
+    gvaclassify->roi_filter = create_roi_filter();
+    if (gvaclassify->roi_filter == NULL)
+        return;
     gvaclassify->classification_history = create_classification_history(gvaclassify);
     if (gvaclassify->classification_history == NULL)
         return;
@@ -169,9 +233,20 @@ void gst_gva_classify_cleanup(GstGvaClassify *gvaclassify) {
         gvaclassify->classification_history = NULL;
     }
 
+    if (gvaclassify->roi_filter) {
+        gchar *stats = roi_filter_get_stats(gvaclassify->roi_filter);
+        GST_INFO_OBJECT(gvaclassify, "Skipped objects: %s", stats);
+        g_free(stats);
+        release_roi_filter(gvaclassify->roi_filter);
+        gvaclassify->roi_filter = NULL;
+    }
+
     g_free(gvaclassify->object_class);
     gvaclassify->object_class = NULL;
 
+    g_free(gvaclassify->zones);
+    gvaclassify->zones = NULL;
+
     releaseClassificationPostProcessor(gvaclassify->base_inference.post_proc);
     gvaclassify->base_inference.post_proc = NULL;
 }
@@ -201,4 +276,12 @@ void on_base_inference_initialized(GvaBaseInference *base_inference) {
     GST_DEBUG_OBJECT(gvaclassify, "on_base_inference_initialized");
 
     base_inference->post_proc = createClassificationPostProcessor(base_inference->inference);
+
+    if (gvaclassify->zones && gvaclassify->zones[0]) {
+        gchar *error_message = NULL;
+        if (!roi_filter_load_zones(gvaclassify->roi_filter, gvaclassify->zones, &error_message)) {
+            GST_ELEMENT_ERROR(gvaclassify, RESOURCE, SETTINGS, ("Failed to load 'zones'"), ("%s", error_message));
+            g_free(error_message);
+        }
+    }
 }
@@ -23,8 +23,12 @@ typedef struct _GstGvaClassify {
     // properties:
     gchar *object_class;
     guint reclassify_interval;
+    gchar *zones;
+    guint min_object_size;
+    guint max_object_size;
 
     struct ClassificationHistory *classification_history;
+    struct ROIFilter *roi_filter;
 } GstGvaClassify;
 
 typedef struct _GstGvaClassifyClass {
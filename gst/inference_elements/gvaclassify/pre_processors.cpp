@@ -13,6 +13,7 @@
 #include "gva_base_inference.h"
 #include "inference_backend/safe_arithmetic.h"
 #include "region_of_interest.h"
+#include "roi_filter.h"
 #include "utils.h"
 
 #include <inference_backend/image_inference.h>
@@ -45,6 +46,12 @@ bool IsROIClassificationNeeded(GvaBaseInference *gva_base_inference, guint curre
         }
     }
 
+    // Check object size and zone, skipped objects do not get into classification history
+    assert(gva_classify->roi_filter != NULL);
+    if (!gva_classify->roi_filter->IsROIAccepted(roi, gva_base_inference->info, gva_classify->min_object_size,
+                                                 gva_classify->max_object_size))
+        return false;
+
     // Check is object recently classified
     assert(gva_classify->classification_history != NULL);
     return (gva_classify->reclassify_interval == 1 ||
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "roi_filter.h"
+
+#include "inference_backend/logger.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int GRID_SIZE = 64;
+
+enum CellState : uint8_t { CELL_OUTSIDE, CELL_INSIDE, CELL_BOUNDARY };
+
+// Crossing number test
+bool IsInsidePolygon(const std::vector<ROIFilter::Point> &polygon, const ROIFilter::Point &point) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const ROIFilter::Point &a = polygon[i];
+        const ROIFilter::Point &b = polygon[j];
+        if ((a.y > point.y) != (b.y > point.y) && point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+// Liang-Barsky clipping of segment ab against rectangle
+bool SegmentIntersectsRect(const ROIFilter::Point &a, const ROIFilter::Point &b, double x0, double y0, double x1,
+                           double y1) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double p[4] = {-dx, dx, -dy, dy};
+    const double q[4] = {a.x - x0, x1 - a.x, a.y - y0, y1 - a.y};
+    double t0 = 0, t1 = 1;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0) {
+            if (q[i] < 0)
+                return false;
+        } else {
+            const double t = q[i] / p[i];
+            if (p[i] < 0)
+                t0 = std::max(t0, t);
+            else
+                t1 = std::min(t1, t);
+            if (t0 > t1)
+                return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> RasterizeZone(const std::vector<ROIFilter::Point> &polygon) {
+    const double cell = 1.0 / GRID_SIZE;
+    std::vector<uint8_t> grid(GRID_SIZE * GRID_SIZE, CELL_OUTSIDE);
+
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const ROIFilter::Point &a = polygon[j];
+        const ROIFilter::Point &b = polygon[i];
+        const int col0 = std::max(0, static_cast<int>(std::min(a.x, b.x) * GRID_SIZE));
+        const int col1 = std::min(GRID_SIZE - 1, static_cast<int>(std::max(a.x, b.x) * GRID_SIZE));
+        const int row0 = std::max(0, static_cast<int>(std::min(a.y, b.y) * GRID_SIZE));
+        const int row1 = std::min(GRID_SIZE - 1, static_cast<int>(std::max(a.y, b.y) * GRID_SIZE));
+        for (int row = row0; row <= row1; row++)
+            for (int col = col0; col <= col1; col++)
+                if (SegmentIntersectsRect(a, b, col * cell, row * cell, (col + 1) * cell, (row + 1) * cell))
+                    grid[row * GRID_SIZE + col] = CELL_BOUNDARY;
+    }
+
+    // cells not crossed by any edge are entirely inside or entirely outside, their center tells which
+    for (int row = 0; row < GRID_SIZE; row++)
+        for (int col = 0; col < GRID_SIZE; col++) {
+            uint8_t &state = grid[row * GRID_SIZE + col];
+            if (state != CELL_BOUNDARY && IsInsidePolygon(polygon, {(col + 0.5) * cell, (row + 0.5) * cell}))
+                state = CELL_INSIDE;
+        }
+    return grid;
+}
+
+ROIFilter::Zone ParseZone(const json &item, size_t index) {
+    ROIFilter::Zone zone;
+    zone.name = item.value("name", "zone" + std::to_string(index));
+    const std::string type = item.value("type", "exclude");
+    if (type == "include")
+        zone.type = ROIFilter::ZoneType::INCLUDE;
+    else if (type == "exclude")
+        zone.type = ROIFilter::ZoneType::EXCLUDE;
+    else
+        throw std::invalid_argument("Zone '" + zone.name + "' has unknown type '" + type +
+                                    "', 'include' or 'exclude' expected");
+
+    const auto points = item.find("points");
+    if (points == item.end() || !points->is_array() || points->size() < 3)
+        throw std::invalid_argument("Zone '" + zone.name + "' must have at least 3 points");
+    for (const json &point : *points) {
+        if (!point.is_array() || point.size() != 2 || !point[0].is_number() || !point[1].is_number())
+            throw std::invalid_argument("Zone '" + zone.name + "' has point which is not [x, y] pair");
+        zone.polygon.push_back({point[0].get<double>(), point[1].get<double>()});
+    }
+    zone.grid = RasterizeZone(zone.polygon);
+    zone.skipped = 0;
+    return zone;
+}
+
+} // anonymous namespace
+
+bool ROIFilter::Zone::Contains(const Point &point) const {
+    if (point.x < 0 || point.y < 0 || point.x >= 1 || point.y >= 1)
+        return IsInsidePolygon(polygon, point);
+    const int col = static_cast<int>(point.x * GRID_SIZE);
+    const int row = static_cast<int>(point.y * GRID_SIZE);
+    const uint8_t state = grid[row * GRID_SIZE + col];
+    if (state == CELL_BOUNDARY)
+        return IsInsidePolygon(polygon, point);
+    return state == CELL_INSIDE;
+}
+
+ROIFilter::ROIFilter() : has_include_zones(false), skipped_by_size(0), skipped_outside_zones(0) {
+}
+
+void ROIFilter::LoadZones(const std::string &zones_file) {
+    try {
+        std::ifstream input_file(zones_file);
+        if (not input_file)
+            throw std::runtime_error("Zones file '" + zones_file + "' was not found");
+        json content;
+        input_file >> content;
+
+        const auto items = content.find("zones");
+        if (items == content.end() || !items->is_array())
+            throw std::invalid_argument("Zones file must contain 'zones' array");
+
+        std::vector<Zone> loaded;
+        for (const json &item : *items)
+            loaded.push_back(ParseZone(item, loaded.size()));
+
+        std::lock_guard<std::mutex> guard(mutex);
+        zones = std::move(loaded);
+        has_include_zones = std::any_of(zones.cbegin(), zones.cend(),
+                                        [](const Zone &zone) { return zone.type == ZoneType::INCLUDE; });
+        GVA_INFO(("Loaded " + std::to_string(zones.size()) + " zone(s) from '" + zones_file + "'").c_str());
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error("Failed to load zones from '" + zones_file + "'"));
+    }
+}
+
+bool ROIFilter::IsROIAccepted(const GstVideoRegionOfInterestMeta *roi, const GstVideoInfo *info, guint min_size,
+                              guint max_size) {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    if ((min_size && std::min(roi->w, roi->h) < min_size) || (max_size && std::max(roi->w, roi->h) > max_size)) {
+        skipped_by_size++;
+        return false;
+    }
+    if (zones.empty() || !info || info->width <= 0 || info->height <= 0)
+        return true;
+
+    const Point center = {(roi->x + roi->w / 2.0) / info->width, (roi->y + roi->h / 2.0) / info->height};
+    bool included = !has_include_zones;
+    for (Zone &zone : zones) {
+        if (zone.type == ZoneType::EXCLUDE) {
+            if (zone.Contains(center)) {
+                zone.skipped++;
+                return false;
+            }
+        } else if (!included && zone.Contains(center)) {
+            included = true;
+        }
+    }
+    if (!included)
+        skipped_outside_zones++;
+    return included;
+}
+
+std::string ROIFilter::GetStats() {
+    std::lock_guard<std::mutex> guard(mutex);
+    std::string stats =
+        "size=" + std::to_string(skipped_by_size) + ",outside-zones=" + std::to_string(skipped_outside_zones);
+    for (const Zone &zone : zones)
+        if (zone.type == ZoneType::EXCLUDE)
+            stats += "," + zone.name + "=" + std::to_string(zone.skipped);
+    return stats;
+}
+
+struct ROIFilter *create_roi_filter(void) {
+    try {
+        return new ROIFilter();
+    } catch (const std::exception &e) {
+        GVA_ERROR(Utils::createNestedErrorMsg(e).c_str());
+        return nullptr;
+    }
+}
+
+void release_roi_filter(struct ROIFilter *roi_filter) {
+    delete roi_filter;
+}
+
+gboolean roi_filter_load_zones(struct ROIFilter *roi_filter, const gchar *zones_file, gchar **error_message) {
+    try {
+        if (!roi_filter)
+            throw std::invalid_argument("ROIFilter is null");
+        roi_filter->LoadZones(zones_file ? zones_file : "");
+        return TRUE;
+    } catch (const std::exception &e) {
+        if (error_message)
+            *error_message = g_strdup(Utils::createNestedErrorMsg(e).c_str());
+        return FALSE;
+    }
+}
+
+gchar *roi_filter_get_stats(struct ROIFilter *roi_filter) {
+    if (!roi_filter)
+        return g_strdup("");
+    return g_strdup(roi_filter->GetStats().c_str());
+}
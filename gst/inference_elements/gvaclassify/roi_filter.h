@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+struct ROIFilter;
+struct ROIFilter *create_roi_filter(void);
+void release_roi_filter(struct ROIFilter *roi_filter);
+// Returns FALSE and sets error_message (to be freed with g_free) if zones file can't be loaded
+gboolean roi_filter_load_zones(struct ROIFilter *roi_filter, const gchar *zones_file, gchar **error_message);
+// Returns newly allocated string with number of skipped objects per reason, e.g. "size=3,outside-zones=0,tv=12"
+gchar *roi_filter_get_stats(struct ROIFilter *roi_filter);
+
+G_END_DECLS
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Drops regions of interest by object size and by position of object center relatively to polygon zones, before
+// any pre-processing is done for them. Zone coordinates are normalized to [0, 1] so zones do not depend on
+// resolution. Each zone is rasterized once into a coarse grid: cells fully inside or outside the polygon answer
+// point-in-zone test with a single lookup, only cells crossed by polygon edges fall back to exact test
+struct ROIFilter {
+    enum class ZoneType { INCLUDE, EXCLUDE };
+
+    struct Point {
+        double x;
+        double y;
+    };
+
+    struct Zone {
+        std::string name;
+        ZoneType type;
+        std::vector<Point> polygon;
+        std::vector<uint8_t> grid; // CellState for each of GRID_SIZE x GRID_SIZE cells
+        uint64_t skipped;
+
+        bool Contains(const Point &point) const;
+    };
+
+    std::vector<Zone> zones;
+    bool has_include_zones;
+    uint64_t skipped_by_size;
+    uint64_t skipped_outside_zones;
+    std::mutex mutex;
+
+    ROIFilter();
+
+    void LoadZones(const std::string &zones_file);
+    // min_size and max_size limit smaller and larger side of object in pixels, 0 means no limit
+    bool IsROIAccepted(const GstVideoRegionOfInterestMeta *roi, const GstVideoInfo *info, guint min_size,
+                       guint max_size);
+    std::string GetStats();
+};
+#endif
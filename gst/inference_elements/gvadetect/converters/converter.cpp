@@ -32,9 +32,22 @@ void Converter::clipNormalizedRect(double &x, double &y, double &w, double &h) {
     }
 }
 
-void Converter::addRoi(GstBuffer *buffer, GstVideoInfo *info, double x, double y, double w, double h, int label_id,
+void Converter::addRoi(const InferenceFrame &frame, double x, double y, double w, double h, int label_id,
                        double confidence, GstStructure *detection_tensor, GValueArray *labels) {
+    GstBuffer *buffer = frame.buffer;
+    GstVideoInfo *info = frame.info;
     clipNormalizedRect(x, y, w, h);
+    const bool is_tile =
+        info->width > 0 && info->height > 0 &&
+        (frame.roi.x || frame.roi.y || frame.roi.w != (guint)info->width || frame.roi.h != (guint)info->height);
+    if (is_tile) {
+        // region is a tile, convert to coordinates normalized to the whole frame
+        x = (frame.roi.x + x * frame.roi.w) / info->width;
+        y = (frame.roi.y + y * frame.roi.h) / info->height;
+        w = w * frame.roi.w / info->width;
+        h = h * frame.roi.h / info->height;
+        clipNormalizedRect(x, y, w, h);
+    }
 
     gchar *label = nullptr;
     getLabelByLabelId(labels, label_id, &label);
@@ -52,6 +65,11 @@ void Converter::addRoi(GstBuffer *buffer, GstVideoInfo *info, double x, double y
     gst_structure_set(detection_tensor, "label_id", G_TYPE_INT, label_id, "confidence", G_TYPE_DOUBLE, confidence,
                       "x_min", G_TYPE_DOUBLE, x, "x_max", G_TYPE_DOUBLE, x + w, "y_min", G_TYPE_DOUBLE, y, "y_max",
                       G_TYPE_DOUBLE, y + h, NULL);
+    // cross-tile NMS needs tile the box came from, it removes these fields
+    if (is_tile)
+        gst_structure_set(detection_tensor, TILE_X_FIELD, G_TYPE_UINT, frame.roi.x, TILE_Y_FIELD, G_TYPE_UINT,
+                          frame.roi.y, TILE_W_FIELD, G_TYPE_UINT, frame.roi.w, TILE_H_FIELD, G_TYPE_UINT, frame.roi.h,
+                          NULL);
     gst_video_region_of_interest_meta_add_param(meta, detection_tensor);
 }
 
@@ -10,14 +10,21 @@
 namespace DetectionPlugin {
 namespace Converters {
 
+// Rectangle of the tile (pixels) box was detected on, set in 'detection' structure only for tiled inference
+constexpr char TILE_X_FIELD[] = "tile_x";
+constexpr char TILE_Y_FIELD[] = "tile_y";
+constexpr char TILE_W_FIELD[] = "tile_w";
+constexpr char TILE_H_FIELD[] = "tile_h";
+
 class Converter {
   public:
     virtual ~Converter() = default;
     virtual bool process(const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &output_blobs,
                          const std::vector<std::shared_ptr<InferenceFrame>> &frames, GstStructure *detection_result,
                          double confidence_threshold, GValueArray *labels) = 0;
-    void addRoi(GstBuffer *buffer, GstVideoInfo *info, double x, double y, double w, double h, int label_id,
-                double confidence, GstStructure *detection_tensor, GValueArray *labels);
+    // x, y, w, h are normalized to inferred region of the frame (whole frame or tile)
+    void addRoi(const InferenceFrame &frame, double x, double y, double w, double h, int label_id, double confidence,
+                GstStructure *detection_tensor, GValueArray *labels);
     void clipNormalizedRect(double &x, double &y, double &w, double &h);
     void getLabelByLabelId(GValueArray *labels, int label_id, gchar **out_label);
 
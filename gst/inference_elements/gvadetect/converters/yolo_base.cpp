@@ -52,7 +52,7 @@ void YOLOConverter::storeObjects(std::vector<DetectedObject> &objects, const std
     runNms(objects);
 
     for (DetectedObject &object : objects) {
-        addRoi(frame->buffer, frame->info, object.x, object.y, object.w, object.h, object.class_id, object.confidence,
+        addRoi(*frame, object.x, object.y, object.w, object.h, object.class_id, object.confidence,
                gst_structure_copy(detection_result), labels); // each ROI gets its own copy, which is then
                                                               // owned by GstVideoRegionOfInterestMeta
     }
@@ -9,8 +9,11 @@
 
 #include "../base/inference_impl.h"
 #include "converters/converter.h"
+#include "gva_utils.h"
 #include "inference_backend/logger.h"
 
+#include <algorithm>
+
 using namespace InferenceBackend;
 using namespace DetectionPlugin;
 using namespace Converters;
@@ -25,6 +28,119 @@ LayersInfoMap::iterator findFirstMatch(const std::map<std::string, OutputBlob::P
 LayersInfoMap::iterator findFirstMatchOrAppend(const std::map<std::string, OutputBlob::Ptr> &output_blobs,
                                                LayersInfoMap &layers_info);
 
+// Object cut by tile boundary is detected as a full box in one tile and as a part of it in adjacent tile, so besides
+// IoU, box is suppressed if it mostly lies inside more confident box of the same class from another tile and both
+// boxes reach into overlap of their tiles. Nested boxes of distinct objects within one tile are kept
+constexpr double TILE_NMS_IOU_THRESHOLD = 0.5;
+constexpr double TILE_NMS_IOS_THRESHOLD = 0.8;
+
+struct Rect {
+    double x, y, w, h;
+};
+
+struct TileDetection {
+    GstVideoRegionOfInterestMeta *meta;
+    GstStructure *detection;
+    int label_id;
+    double confidence;
+    bool has_tile;
+    Rect tile;
+};
+
+Rect intersect(const Rect &a, const Rect &b) {
+    const double x = std::max(a.x, b.x);
+    const double y = std::max(a.y, b.y);
+    const double w = std::min(a.x + a.w, b.x + b.w) - x;
+    const double h = std::min(a.y + a.h, b.y + b.h) - y;
+    return Rect{x, y, std::max(w, 0.), std::max(h, 0.)};
+}
+
+Rect metaRect(const GstVideoRegionOfInterestMeta *meta) {
+    return Rect{static_cast<double>(meta->x), static_cast<double>(meta->y), static_cast<double>(meta->w),
+                static_cast<double>(meta->h)};
+}
+
+bool readTile(const GstStructure *detection, Rect &tile) {
+    guint x, y, w, h;
+    if (!gst_structure_get_uint(detection, TILE_X_FIELD, &x) || !gst_structure_get_uint(detection, TILE_Y_FIELD, &y) ||
+        !gst_structure_get_uint(detection, TILE_W_FIELD, &w) || !gst_structure_get_uint(detection, TILE_H_FIELD, &h))
+        return false;
+    tile = Rect{static_cast<double>(x), static_cast<double>(y), static_cast<double>(w), static_cast<double>(h)};
+    return true;
+}
+
+// Boxes from different tiles which both intersect overlap of these tiles may be parts of one object cut by boundary
+bool mayBeCutByTileBoundary(const TileDetection &a, const TileDetection &b) {
+    if (!a.has_tile || !b.has_tile)
+        return false;
+    if (a.tile.x == b.tile.x && a.tile.y == b.tile.y && a.tile.w == b.tile.w && a.tile.h == b.tile.h)
+        return false;
+    const Rect overlap = intersect(a.tile, b.tile);
+    if (overlap.w <= 0 || overlap.h <= 0)
+        return false;
+    const Rect a_in_overlap = intersect(metaRect(a.meta), overlap);
+    const Rect b_in_overlap = intersect(metaRect(b.meta), overlap);
+    return a_in_overlap.w > 0 && a_in_overlap.h > 0 && b_in_overlap.w > 0 && b_in_overlap.h > 0;
+}
+
+void runCrossTileNms(GstBuffer *buffer, const std::string &model_name) {
+    ITT_TASK(__FUNCTION__);
+    std::vector<TileDetection> detections;
+    GstVideoRegionOfInterestMeta *meta = nullptr;
+    gpointer state = nullptr;
+    while ((meta = GST_VIDEO_REGION_OF_INTEREST_META_ITERATE(buffer, &state))) {
+        GstStructure *detection = gst_video_region_of_interest_meta_get_param(meta, "detection");
+        if (!detection)
+            continue;
+        const gchar *detection_model = gst_structure_get_string(detection, "model_name");
+        if (!detection_model || model_name != detection_model)
+            continue; // added by another element
+        TileDetection tile_detection = {meta, detection, -1, 0, false, Rect()};
+        gst_structure_get_int(detection, "label_id", &tile_detection.label_id);
+        gst_structure_get_double(detection, "confidence", &tile_detection.confidence);
+        tile_detection.has_tile = readTile(detection, tile_detection.tile);
+        detections.push_back(tile_detection);
+    }
+
+    std::stable_sort(detections.begin(), detections.end(), [](const TileDetection &a, const TileDetection &b) {
+        return a.confidence > b.confidence;
+    });
+
+    std::vector<bool> suppressed(detections.size(), false);
+    for (size_t i = 0; i < detections.size(); i++) {
+        if (suppressed[i])
+            continue;
+        const GstVideoRegionOfInterestMeta *kept = detections[i].meta;
+        const double kept_area = static_cast<double>(kept->w) * kept->h;
+        for (size_t j = i + 1; j < detections.size(); j++) {
+            if (suppressed[j] || detections[j].label_id != detections[i].label_id)
+                continue;
+            const GstVideoRegionOfInterestMeta *other = detections[j].meta;
+            const double inter_w =
+                std::min<double>(kept->x + kept->w, other->x + other->w) - std::max(kept->x, other->x);
+            const double inter_h =
+                std::min<double>(kept->y + kept->h, other->y + other->h) - std::max(kept->y, other->y);
+            if (inter_w <= 0 || inter_h <= 0)
+                continue;
+            const double inter_area = inter_w * inter_h;
+            const double other_area = static_cast<double>(other->w) * other->h;
+            const double min_area = std::min(kept_area, other_area);
+            if (inter_area / (kept_area + other_area - inter_area) > TILE_NMS_IOU_THRESHOLD ||
+                (min_area > 0 && inter_area / min_area > TILE_NMS_IOS_THRESHOLD &&
+                 mayBeCutByTileBoundary(detections[i], detections[j])))
+                suppressed[j] = true;
+        }
+    }
+
+    for (size_t i = 0; i < detections.size(); i++) {
+        if (suppressed[i])
+            gst_buffer_remove_meta(buffer, reinterpret_cast<GstMeta *>(detections[i].meta));
+        else if (detections[i].has_tile)
+            gst_structure_remove_fields(detections[i].detection, TILE_X_FIELD, TILE_Y_FIELD, TILE_W_FIELD,
+                                        TILE_H_FIELD, NULL);
+    }
+}
+
 ConverterUniquePtr createConverter(const GstStructure *model_proc_info) {
     std::unique_ptr<Converter> converter;
     converter = ConverterUniquePtr(Converter::create(model_proc_info));
@@ -130,3 +246,8 @@ void DetectionPostProcessor::process(const std::map<std::string, OutputBlob::Ptr
         std::throw_with_nested(std::runtime_error("Failed to extract detection results"));
     }
 }
+
+void DetectionPostProcessor::finalize_frame(GstBuffer *buffer, GvaBaseInference *gva_base_inference) {
+    if (gva_base_inference->tile_columns * gva_base_inference->tile_rows > 1)
+        runCrossTileNms(buffer, model_name);
+}
@@ -39,6 +39,7 @@ class DetectionPostProcessor : public PostProcessor {
     DetectionPostProcessor(const InferenceImpl *inference_impl);
     void process(const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &output_blobs,
                  std::vector<std::shared_ptr<InferenceFrame>> &frames);
+    void finalize_frame(GstBuffer *buffer, GvaBaseInference *gva_base_inference);
     ~DetectionPostProcessor() = default;
 };
 
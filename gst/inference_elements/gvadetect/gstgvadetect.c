@@ -21,12 +21,23 @@
 enum {
     PROP_0,
     PROP_THRESHOLD,
+    PROP_TILE_COLUMNS,
+    PROP_TILE_ROWS,
+    PROP_TILE_OVERLAP,
 };
 
 #define DEFALUT_MIN_THRESHOLD 0.
 #define DEFALUT_MAX_THRESHOLD 1.
 #define DEFALUT_THRESHOLD 0.5
 
+#define DEFAULT_MIN_TILES 1
+#define DEFAULT_MAX_TILES 16
+#define DEFAULT_TILES 1
+
+#define DEFAULT_MIN_TILE_OVERLAP 0.
+#define DEFAULT_MAX_TILE_OVERLAP 0.9
+#define DEFAULT_TILE_OVERLAP 0.1
+
 GST_DEBUG_CATEGORY_STATIC(gst_gva_detect_debug_category);
 #define GST_CAT_DEFAULT gst_gva_detect_debug_category
 
@@ -46,6 +57,15 @@ void gst_gva_detect_set_property(GObject *object, guint property_id, const GValu
     case PROP_THRESHOLD:
         gvadetect->threshold = g_value_get_float(value);
         break;
+    case PROP_TILE_COLUMNS:
+        gvadetect->base_inference.tile_columns = g_value_get_uint(value);
+        break;
+    case PROP_TILE_ROWS:
+        gvadetect->base_inference.tile_rows = g_value_get_uint(value);
+        break;
+    case PROP_TILE_OVERLAP:
+        gvadetect->base_inference.tile_overlap = g_value_get_double(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -61,6 +81,15 @@ void gst_gva_detect_get_property(GObject *object, guint property_id, GValue *val
     case PROP_THRESHOLD:
         g_value_set_float(value, gvadetect->threshold);
         break;
+    case PROP_TILE_COLUMNS:
+        g_value_set_uint(value, gvadetect->base_inference.tile_columns);
+        break;
+    case PROP_TILE_ROWS:
+        g_value_set_uint(value, gvadetect->base_inference.tile_rows);
+        break;
+    case PROP_TILE_OVERLAP:
+        g_value_set_double(value, gvadetect->base_inference.tile_overlap);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -93,6 +122,29 @@ void gst_gva_detect_class_init(GstGvaDetectClass *klass) {
                            "with confidence values above the threshold will be added to the frame",
                            DEFALUT_MIN_THRESHOLD, DEFALUT_MAX_THRESHOLD, DEFALUT_THRESHOLD,
                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TILE_COLUMNS,
+        g_param_spec_uint("tile-columns", "Tile columns",
+                          "Number of columns of overlapping tiles frame is split into, each tile is inferred "
+                          "separately at network input resolution, so small objects are not lost on high-resolution "
+                          "frames. Detections from adjacent tiles are merged. Set batch-size to number of tiles to "
+                          "infer all tiles of a frame in one batch",
+                          DEFAULT_MIN_TILES, DEFAULT_MAX_TILES, DEFAULT_TILES,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TILE_ROWS,
+        g_param_spec_uint("tile-rows", "Tile rows", "Number of rows of tiles, see tile-columns", DEFAULT_MIN_TILES,
+                          DEFAULT_MAX_TILES, DEFAULT_TILES, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TILE_OVERLAP,
+        g_param_spec_double("tile-overlap", "Tile overlap",
+                            "Overlap of adjacent tiles as a fraction of tile size. Should be large enough for an "
+                            "object at tile boundary to be fully visible in one of the tiles",
+                            DEFAULT_MIN_TILE_OVERLAP, DEFAULT_MAX_TILE_OVERLAP, DEFAULT_TILE_OVERLAP,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 }
 
 void gst_gva_detect_init(GstGvaDetect *gvadetect) {
@@ -100,6 +152,9 @@ void gst_gva_detect_init(GstGvaDetect *gvadetect) {
     GST_DEBUG_OBJECT(gvadetect, "%s", GST_ELEMENT_NAME(GST_ELEMENT(gvadetect)));
 
     gvadetect->threshold = DEFALUT_THRESHOLD;
+    gvadetect->base_inference.tile_columns = DEFAULT_TILES;
+    gvadetect->base_inference.tile_rows = DEFAULT_TILES;
+    gvadetect->base_inference.tile_overlap = DEFAULT_TILE_OVERLAP;
 }
 
 void gst_gva_detect_finilize(GObject *object) {
@@ -17,6 +17,8 @@
 #include "gstgvatrack.h"
 #include "gstgvawatermark.h"
 
+#include "gst_latency_tracer.h"
+
 #include "gva_json_meta.h"
 #include "gva_tensor_meta.h"
 
@@ -45,6 +47,9 @@ static gboolean plugin_init(GstPlugin *plugin) {
     if (!gst_element_register(plugin, "gvatrack", GST_RANK_NONE, GST_TYPE_GVA_TRACK))
         return FALSE;
 
+    if (!gst_tracer_register(plugin, "gvalatencytracer", GST_TYPE_GVA_LATENCY_TRACER))
+        return FALSE;
+
     // register metadata
     gst_gva_json_meta_get_info();
     gst_gva_json_meta_api_get_type();
@@ -92,6 +92,11 @@ void ImageInferenceAsync::GetModelImageInputInfo(size_t &width, size_t &height,
     inference->GetModelImageInputInfo(width, height, batch_size, format);
 }
 
+void ImageInferenceAsync::WarmUp(const Image &) {
+    // VA-API images are allocated lazily on first frame, so system memory image can't be used here
+    GVA_WARNING("Warm-up is not supported with 'vaapi' pre-processing and will be skipped");
+}
+
 bool ImageInferenceAsync::IsQueueFull() {
     return inference->IsQueueFull();
 }
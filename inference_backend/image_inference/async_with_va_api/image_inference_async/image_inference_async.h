@@ -36,6 +36,8 @@ class ImageInferenceAsync : public ImageInference {
 
     void GetModelImageInputInfo(size_t &width, size_t &height, size_t &batch_size, int &format) const override;
 
+    void WarmUp(const Image &image) override;
+
     bool IsQueueFull() override;
 
     void Flush() override;
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "blob_record.h"
+
+#include "inference_backend/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace InferenceBackend;
+
+namespace BlobRecord {
+
+namespace {
+
+constexpr size_t GROWTH_SIZE = 64 * 1024 * 1024;
+
+size_t Align(size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+std::string ErrnoMessage(const std::string &message, const std::string &path) {
+    return message + " '" + path + "': " + std::strerror(errno);
+}
+
+struct Mapping {
+    void *data;
+    size_t size;
+
+    Mapping(void *data, size_t size) : data(data), size(size) {
+    }
+    ~Mapping() {
+        munmap(data, size);
+    }
+};
+
+class RecordedOutputBlob : public OutputBlob {
+  public:
+    RecordedOutputBlob(std::shared_ptr<Mapping> mapping, std::vector<size_t> dims, const LayerHeader &layer,
+                       const void *data)
+        : mapping(std::move(mapping)), dims(std::move(dims)), layout(static_cast<Layout>(layer.layout)),
+          precision(static_cast<Precision>(layer.precision)), data(data) {
+    }
+
+    const std::vector<size_t> &GetDims() const override {
+        return dims;
+    }
+    Layout GetLayout() const override {
+        return layout;
+    }
+    Precision GetPrecision() const override {
+        return precision;
+    }
+    const void *GetData() const override {
+        return data;
+    }
+
+  private:
+    std::shared_ptr<Mapping> mapping;
+    std::vector<size_t> dims;
+    Layout layout;
+    Precision precision;
+    const void *data;
+};
+
+} // namespace
+
+Recorder::Recorder(const std::string &path, const std::string &model_name, size_t width, size_t height,
+                   size_t batch_size)
+    : fd(-1), mapping(nullptr), capacity(0), offset(0) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error(ErrnoMessage("Failed to create blob record file", path));
+    try {
+        Reserve(sizeof(FileHeader));
+    } catch (const std::exception &e) {
+        close(fd);
+        std::throw_with_nested(std::runtime_error("Failed to initialize blob record file '" + path + "'"));
+    }
+
+    FileHeader header = FileHeader();
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.width = width;
+    header.height = height;
+    header.batch_size = batch_size;
+    model_name.copy(header.model_name, sizeof(header.model_name) - 1);
+    std::memcpy(mapping, &header, sizeof(header));
+    offset = sizeof(header);
+}
+
+Recorder::~Recorder() {
+    if (mapping)
+        munmap(mapping, capacity);
+    // drop preallocated tail, so file ends right after the last record
+    if (ftruncate(fd, offset) != 0)
+        GVA_WARNING("Failed to truncate blob record file");
+    close(fd);
+}
+
+// File is extended by large steps and remapped, space beyond last record stays zero-filled and reads as end of file
+void Recorder::Reserve(size_t size) {
+    if (size <= capacity)
+        return;
+    const size_t new_capacity = std::max(capacity * 2, (size + GROWTH_SIZE - 1) / GROWTH_SIZE * GROWTH_SIZE);
+    if (mapping) {
+        munmap(mapping, capacity);
+        mapping = nullptr;
+        capacity = 0;
+    }
+    if (ftruncate(fd, new_capacity) != 0)
+        throw std::runtime_error(std::string("Failed to extend blob record file: ") + std::strerror(errno));
+    void *data = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+        throw std::runtime_error(std::string("Failed to map blob record file: ") + std::strerror(errno));
+    mapping = static_cast<uint8_t *>(data);
+    capacity = new_capacity;
+}
+
+void Recorder::Write(const std::vector<FrameKey> &frames, const std::vector<Layer> &layers) {
+    size_t size = sizeof(RecordHeader) + frames.size() * sizeof(FrameKey);
+    for (const Layer &layer : layers)
+        size += sizeof(LayerHeader) + layer.dims.size() * sizeof(uint64_t) + Align(layer.name.size()) +
+                Align(layer.size);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Reserve(offset + size);
+    uint8_t *record = mapping + offset;
+    RecordHeader header = RecordHeader();
+    header.frames_number = frames.size();
+    header.layers_number = layers.size();
+    std::memcpy(record, &header, sizeof(header));
+    uint8_t *position = record + sizeof(header);
+    for (const FrameKey &frame : frames) {
+        std::memcpy(position, &frame, sizeof(frame));
+        position += sizeof(frame);
+    }
+    for (const Layer &layer : layers) {
+        LayerHeader layer_header = LayerHeader();
+        layer_header.data_size = layer.size;
+        layer_header.precision = layer.precision;
+        layer_header.layout = layer.layout;
+        layer_header.dims_number = layer.dims.size();
+        layer_header.name_size = layer.name.size();
+        std::memcpy(position, &layer_header, sizeof(layer_header));
+        position += sizeof(layer_header);
+        for (size_t dim : layer.dims) {
+            const uint64_t value = dim;
+            std::memcpy(position, &value, sizeof(value));
+            position += sizeof(value);
+        }
+        std::memcpy(position, layer.name.data(), layer.name.size());
+        position += Align(layer.name.size());
+        std::memcpy(position, layer.data, layer.size);
+        position += Align(layer.size);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header.size = size;
+    std::memcpy(record, &header.size, sizeof(header.size));
+    offset += size;
+}
+
+Reader::Reader(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::invalid_argument(ErrnoMessage("Failed to open blob record file", path));
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        throw std::invalid_argument("Blob record file '" + path + "' is too small");
+    }
+    const size_t file_size = st.st_size;
+    void *data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error(ErrnoMessage("Failed to map blob record file", path));
+    auto mapping = std::make_shared<Mapping>(data, file_size);
+    const uint8_t *begin = static_cast<const uint8_t *>(data);
+
+    std::memcpy(&header, begin, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION)
+        throw std::invalid_argument("File '" + path + "' is not blob record of version " + std::to_string(VERSION));
+    header.model_name[sizeof(header.model_name) - 1] = '\0';
+
+    size_t offset = sizeof(header);
+    while (offset + sizeof(RecordHeader) <= file_size) {
+        RecordHeader record_header;
+        std::memcpy(&record_header, begin + offset, sizeof(record_header));
+        // zero size is preallocated space or record interrupted by crash
+        if (record_header.size == 0)
+            break;
+        if (record_header.size > file_size - offset)
+            throw std::invalid_argument("Blob record file '" + path + "' is corrupted at offset " +
+                                        std::to_string(offset));
+        const uint8_t *position = begin + offset + sizeof(record_header);
+        const uint8_t *end = begin + offset + record_header.size;
+        auto check = [&](size_t size) {
+            if (size > static_cast<size_t>(end - position))
+                throw std::invalid_argument("Blob record file '" + path + "' has truncated record at offset " +
+                                            std::to_string(offset));
+        };
+
+        Record record;
+        check(record_header.frames_number * sizeof(FrameKey));
+        record.frames.resize(record_header.frames_number);
+        std::memcpy(record.frames.data(), position, record_header.frames_number * sizeof(FrameKey));
+        position += record_header.frames_number * sizeof(FrameKey);
+        for (uint32_t i = 0; i < record_header.layers_number; i++) {
+            LayerHeader layer;
+            check(sizeof(layer));
+            std::memcpy(&layer, position, sizeof(layer));
+            position += sizeof(layer);
+
+            check(layer.dims_number * sizeof(uint64_t));
+            std::vector<size_t> dims(layer.dims_number);
+            for (size_t &dim : dims) {
+                uint64_t value;
+                std::memcpy(&value, position, sizeof(value));
+                dim = value;
+                position += sizeof(value);
+            }
+            check(Align(layer.name_size));
+            std::string name(reinterpret_cast<const char *>(position), layer.name_size);
+            position += Align(layer.name_size);
+            check(Align(layer.data_size));
+            record.blobs[name] = std::make_shared<RecordedOutputBlob>(mapping, std::move(dims), layer, position);
+            position += Align(layer.data_size);
+        }
+        records.push_back(std::move(record));
+        offset += record_header.size;
+    }
+}
+
+std::string RecordPathFromEnvironment(const std::string &model_name) {
+    static std::atomic<unsigned> instance(0);
+    const char *record_dir = std::getenv("GVA_BLOB_RECORD_DIR");
+    if (!record_dir || !*record_dir)
+        return std::string();
+    std::string name = model_name;
+    std::replace_if(name.begin(), name.end(), [](char c) { return !isalnum(c) && c != '-' && c != '_'; }, '_');
+    return std::string(record_dir) + "/" + name + "-" + std::to_string(getpid()) + "-" + std::to_string(instance++) +
+           FILE_EXTENSION;
+}
+
+} // namespace BlobRecord
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/image_inference.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Output blobs of inference requests recorded into append-only file. File starts with FileHeader and is followed by
+// records, each record is output of one inference request:
+//   RecordHeader, FrameKey of each request in the batch,
+//   for each layer: LayerHeader, dims (uint64_t each), name, data.
+// Name and data are padded to 8 bytes. All values are in native byte order.
+namespace BlobRecord {
+
+constexpr char MAGIC[8] = {'G', 'V', 'A', 'B', 'L', 'O', 'B', 'S'};
+constexpr uint32_t VERSION = 2;
+constexpr auto FILE_EXTENSION = ".gvablobs";
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t width; // image input of the network
+    uint32_t height;
+    uint32_t batch_size;
+    char model_name[64];
+};
+
+struct RecordHeader {
+    uint64_t size; // whole record including header, record is committed by writing its size last
+    uint32_t frames_number;
+    uint32_t layers_number;
+};
+
+// Identifies inference request: all ROIs of a frame share timestamp, so position of ROI among them is recorded too
+struct FrameKey {
+    uint64_t timestamp;
+    uint64_t index;
+
+    bool operator==(const FrameKey &other) const {
+        return timestamp == other.timestamp && index == other.index;
+    }
+};
+
+struct LayerHeader {
+    uint64_t data_size;
+    uint32_t precision; // InferenceEngine::Precision
+    uint32_t layout;    // InferenceEngine::Layout
+    uint32_t dims_number;
+    uint32_t name_size;
+};
+
+class Recorder {
+  public:
+    struct Layer {
+        std::string name;
+        std::vector<size_t> dims;
+        int precision;
+        int layout;
+        const void *data;
+        size_t size;
+    };
+
+    Recorder(const std::string &path, const std::string &model_name, size_t width, size_t height, size_t batch_size);
+    ~Recorder();
+
+    // Thread-safe, called from completion callbacks of inference requests
+    void Write(const std::vector<FrameKey> &frames, const std::vector<Layer> &layers);
+
+  private:
+    void Reserve(size_t size);
+
+    int fd;
+    uint8_t *mapping;
+    size_t capacity;
+    size_t offset;
+    std::mutex mutex;
+};
+
+class Reader {
+  public:
+    struct Record {
+        std::vector<FrameKey> frames;
+        // blobs point into memory-mapped file, which is kept mapped while any of them is alive
+        std::map<std::string, InferenceBackend::OutputBlob::Ptr> blobs;
+    };
+
+    explicit Reader(const std::string &path);
+
+    const FileHeader &GetHeader() const {
+        return header;
+    }
+    const std::vector<Record> &GetRecords() const {
+        return records;
+    }
+
+  private:
+    FileHeader header;
+    std::vector<Record> records;
+};
+
+// Path of new record file in directory set by GVA_BLOB_RECORD_DIR environment variable, empty if it is not set
+std::string RecordPathFromEnvironment(const std::string &model_name);
+
+} // namespace BlobRecord
@@ -5,16 +5,22 @@
  ******************************************************************************/
 
 #include "image_inference_async/image_inference_async.h"
+#include "mock_image_inference.h"
 #include "openvino_image_inference.h"
 
 using namespace InferenceBackend;
 
+constexpr uint64_t ImageInference::NO_TIMESTAMP;
+
 ImageInference::Ptr ImageInference::make_shared(MemoryType /*type*/, const std::string &model,
                                                 const std::map<std::string, std::map<std::string, std::string>> &config,
                                                 Allocator *allocator, CallbackFunc callback,
                                                 ErrorHandlingFunc error_handler) {
-#ifdef HAVE_VAAPI
     const std::map<std::string, std::string> &base = config.at(KEY_BASE);
+    auto device = base.find(KEY_DEVICE);
+    if (device != base.end() && device->second == "MOCK")
+        return std::make_shared<MockImageInference>(model, config, callback, error_handler);
+#ifdef HAVE_VAAPI
     auto it = base.find(KEY_PRE_PROCESSOR_TYPE);
     if (it != base.end() && it->second == "vaapi") {
         auto infer = std::make_shared<OpenVINOImageInference>(model, config, allocator, callback, error_handler);
@@ -0,0 +1,446 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "mock_image_inference.h"
+
+#include "blob_record.h"
+#include "inference_backend/logger.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+using namespace InferenceBackend;
+using json = nlohmann::json;
+
+namespace {
+
+class MockOutputBlob : public OutputBlob {
+  public:
+    MockOutputBlob(std::vector<size_t> dims, std::vector<float> data) : dims(std::move(dims)), data(std::move(data)) {
+    }
+
+    const std::vector<size_t> &GetDims() const override {
+        return dims;
+    }
+
+    Layout GetLayout() const override {
+        switch (dims.size()) {
+        case 2:
+            return Layout::NC;
+        case 4:
+            return Layout::NCHW;
+        default:
+            return Layout::ANY;
+        }
+    }
+
+    Precision GetPrecision() const override {
+        return Precision::FP32;
+    }
+
+    const void *GetData() const override {
+        return data.data();
+    }
+
+  private:
+    std::vector<size_t> dims;
+    std::vector<float> data;
+};
+
+size_t ElementsNumber(const std::vector<size_t> &dims) {
+    return std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<size_t>());
+}
+
+// DetectionOutput layer [1, 1, N, 7]: rows of [image_id, label, confidence, x_min, y_min, x_max, y_max], objects of
+// each image are laid out in a grid, unused rows are terminated with image_id = -1
+std::vector<float> GenerateSsd(const json &layer, std::vector<size_t> &dims, size_t batch_size) {
+    if (dims.size() != 4 || dims[3] != 7)
+        throw std::invalid_argument("'ssd' generator expects dims [1, 1, N, 7]");
+    const size_t objects = layer.value("objects", 1);
+    const float label = layer.value("label", 1);
+    const float confidence = layer.value("confidence", 0.9f);
+    const size_t rows = dims[2];
+    if (objects * batch_size > rows)
+        throw std::invalid_argument("'ssd' generator: " + std::to_string(objects) + " objects for each of " +
+                                    std::to_string(batch_size) + " images do not fit into " + std::to_string(rows) +
+                                    " rows");
+
+    std::vector<float> data(rows * 7, 0.0f);
+    const size_t grid = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(objects))));
+    const float cell = 1.0f / grid;
+    for (size_t row = 0; row < rows; row++) {
+        float *object = &data[row * 7];
+        if (row >= objects * batch_size) {
+            object[0] = -1;
+            continue;
+        }
+        const size_t index = row % objects;
+        const float x = (index % grid) * cell;
+        const float y = (index / grid) * cell;
+        object[0] = static_cast<float>(row / objects);
+        object[1] = label;
+        object[2] = confidence;
+        object[3] = x + 0.1f * cell;
+        object[4] = y + 0.1f * cell;
+        object[5] = x + 0.9f * cell;
+        object[6] = y + 0.9f * cell;
+    }
+    return data;
+}
+
+// Scores [batch, C, ...] with low noise and single peak at 'label' class for each image
+std::vector<float> GenerateClassification(const json &layer, std::vector<size_t> &dims, size_t batch_size,
+                                          std::mt19937 &engine) {
+    if (dims.size() < 2)
+        throw std::invalid_argument("'classification' generator expects dims [1, C, ...]");
+    dims[0] *= batch_size;
+    const size_t classes = ElementsNumber(dims) / dims[0];
+    const size_t label = layer.value("label", 0);
+    if (label >= classes)
+        throw std::invalid_argument("'classification' generator: label " + std::to_string(label) +
+                                    " is out of range of " + std::to_string(classes) + " classes");
+
+    std::uniform_real_distribution<float> noise(0.0f, 0.1f / classes);
+    std::vector<float> data(ElementsNumber(dims));
+    for (float &value : data)
+        value = noise(engine);
+    for (size_t i = 0; i < dims[0]; i++)
+        data[i * classes + label] = layer.value("confidence", 0.9f);
+    return data;
+}
+
+// Uniformly distributed values, e.g. for YOLO region layers to load decoding and NMS with many candidates
+std::vector<float> GenerateRandom(const json &layer, std::vector<size_t> &dims, size_t batch_size,
+                                  std::mt19937 &engine) {
+    dims[0] *= batch_size;
+    const std::vector<float> range = layer.value("range", std::vector<float>{0.0f, 1.0f});
+    if (range.size() != 2 || range[0] > range[1])
+        throw std::invalid_argument("'random' generator expects range [min, max]");
+
+    std::uniform_real_distribution<float> distribution(range[0], range[1]);
+    std::vector<float> data(ElementsNumber(dims));
+    for (float &value : data)
+        value = distribution(engine);
+    return data;
+}
+
+// Raw FP32 data of the whole batch, e.g. saved from real network output
+std::vector<float> ReadFile(const json &layer, const std::vector<size_t> &dims, const std::string &directory) {
+    std::string path = layer.at("file").get<std::string>();
+    if (!path.empty() && path[0] != '/')
+        path = directory + path;
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        throw std::invalid_argument("Can not open blob file '" + path + "'");
+
+    std::vector<float> data(ElementsNumber(dims));
+    const std::streamoff size = file.tellg();
+    if (size != static_cast<std::streamoff>(data.size() * sizeof(float)))
+        throw std::invalid_argument("Size of blob file '" + path + "' is " + std::to_string(size) +
+                                    " bytes, expected " + std::to_string(data.size() * sizeof(float)));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), size);
+    return data;
+}
+
+bool IsBlobRecord(const std::string &model) {
+    const std::string extension = BlobRecord::FILE_EXTENSION;
+    return model.size() > extension.size() &&
+           model.compare(model.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace
+
+MockImageInference::MockImageInference(const std::string &model,
+                                       const std::map<std::string, std::map<std::string, std::string>> &config,
+                                       CallbackFunc callback, ErrorHandlingFunc error_handler)
+    : callback(callback), handleError(error_handler), width(0), height(0),
+      batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))), nireq(0), latency(0), next_record(0),
+      requests_processing(0), stop(false) {
+    try {
+        if (IsBlobRecord(model))
+            ReadRecord(model);
+        else
+            ReadDescription(model);
+
+        const std::map<std::string, std::string> &base_config = config.at(KEY_BASE);
+        const int nireq_config = std::stoi(base_config.at(KEY_NIREQ));
+        if (nireq_config > 0)
+            nireq = nireq_config;
+        // only software pre-processing is simulated, other types pass images through as with 'ie' pre-processor
+        auto pre_processor_type = base_config.find(KEY_PRE_PROCESSOR_TYPE);
+        if (pre_processor_type != base_config.end() && pre_processor_type->second == "opencv")
+            pre_processor.reset(PreProc::Create(PreProcessType::OpenCV));
+
+        for (size_t i = 0; i < nireq; i++) {
+            std::unique_ptr<BatchRequest> request(new BatchRequest());
+            if (pre_processor)
+                request->input.resize(batch_size * 3 * width * height);
+            free_requests.push_back(std::move(request));
+        }
+        for (size_t i = 0; i < nireq; i++)
+            workers.emplace_back(&MockImageInference::WorkingFunction, this);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error("Failed to construct MockImageInference"));
+    }
+}
+
+MockImageInference::~MockImageInference() {
+    Close();
+}
+
+void MockImageInference::ReadDescription(const std::string &model) {
+    std::ifstream file(model);
+    if (!file)
+        throw std::invalid_argument("Can not open mock model description '" + model + "'");
+    json description;
+    try {
+        file >> description;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::invalid_argument("Mock model description '" + model + "' is not valid JSON"));
+    }
+
+    const size_t name_start = model.find_last_of('/') + 1;
+    const std::string directory = model.substr(0, name_start);
+    model_name = description.value("name", model.substr(name_start, model.find_last_of('.') - name_start));
+    const json input = description.value("input", json::object());
+    width = input.value("width", 300);
+    height = input.value("height", 300);
+    latency = std::chrono::microseconds(static_cast<int64_t>(description.value("latency_ms", 0.0) * 1000));
+    nireq = description.value("nireq", 1);
+    if (width == 0 || height == 0 || nireq == 0 || batch_size == 0)
+        throw std::invalid_argument("Mock model description '" + model + "' has zero input size or nireq");
+
+    std::mt19937 engine(description.value("seed", 0u));
+    for (const json &layer : description.at("outputs")) {
+        const std::string name = layer.at("name").get<std::string>();
+        const std::string generator = layer.value("generator", "zeros");
+        std::vector<size_t> dims = layer.at("dims").get<std::vector<size_t>>();
+        if (dims.empty() || ElementsNumber(dims) == 0)
+            throw std::invalid_argument("Output layer '" + name + "' has empty dims");
+
+        std::vector<float> data;
+        try {
+            if (generator == "ssd") {
+                data = GenerateSsd(layer, dims, batch_size);
+            } else if (generator == "classification") {
+                data = GenerateClassification(layer, dims, batch_size, engine);
+            } else if (generator == "random") {
+                data = GenerateRandom(layer, dims, batch_size, engine);
+            } else if (generator == "file") {
+                data = ReadFile(layer, dims, directory);
+            } else if (generator == "zeros") {
+                dims[0] *= batch_size;
+                data.assign(ElementsNumber(dims), 0.0f);
+            } else {
+                throw std::invalid_argument("Unknown generator '" + generator + "'");
+            }
+        } catch (const std::exception &e) {
+            std::throw_with_nested(std::invalid_argument("Failed to generate output layer '" + name + "'"));
+        }
+        output_blobs[name] = std::make_shared<MockOutputBlob>(std::move(dims), std::move(data));
+    }
+    if (output_blobs.empty())
+        throw std::invalid_argument("Mock model description '" + model + "' has no output layers");
+}
+
+void MockImageInference::ReadRecord(const std::string &model) {
+    blob_record.reset(new BlobRecord::Reader(model));
+    const std::vector<BlobRecord::Reader::Record> &records = blob_record->GetRecords();
+    if (records.empty())
+        throw std::invalid_argument("Blob record file '" + model + "' has no records");
+
+    const BlobRecord::FileHeader &header = blob_record->GetHeader();
+    model_name = header.model_name;
+    // network without image input is recorded with zero size
+    width = header.width ? header.width : 300;
+    height = header.height ? header.height : 300;
+    nireq = 1;
+    if (header.batch_size != batch_size) {
+        const std::string msg = "Blob record '" + model + "' was captured with batch size " +
+                                std::to_string(header.batch_size) + ", replayed with " + std::to_string(batch_size);
+        GVA_WARNING(msg.c_str());
+    }
+    for (size_t i = 0; i < records.size(); i++) {
+        const std::vector<BlobRecord::FrameKey> &frames = records[i].frames;
+        if (!frames.empty() && frames.front().timestamp != NO_TIMESTAMP)
+            records_by_key[std::make_pair(frames.front().timestamp, frames.front().index)].push_back(i);
+    }
+}
+
+// Record is looked up by timestamp and ROI index of the first frame, so results match requests even if they were
+// completed out of order, and then all frames of the request are checked against the record. Frames without timestamp
+// take records sequentially, replay wraps around at the end
+const std::map<std::string, OutputBlob::Ptr> &MockImageInference::NextRecord(const std::vector<IFramePtr> &frames) {
+    const std::vector<BlobRecord::Reader::Record> &records = blob_record->GetRecords();
+    std::vector<BlobRecord::FrameKey> keys;
+    for (const IFramePtr &frame : frames)
+        keys.push_back(frame ? BlobRecord::FrameKey{frame->GetTimestamp(), frame->GetIndex()}
+                             : BlobRecord::FrameKey{NO_TIMESTAMP, 0});
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t index = next_record;
+    if (!keys.empty() && keys.front().timestamp != NO_TIMESTAMP) {
+        auto it = records_by_key.find(std::make_pair(keys.front().timestamp, keys.front().index));
+        if (it == records_by_key.end() || it->second.empty())
+            throw std::runtime_error("Blob record has no output for frame with timestamp " +
+                                     std::to_string(keys.front().timestamp) + ", ROI index " +
+                                     std::to_string(keys.front().index));
+        index = it->second.front();
+        it->second.pop_front();
+        if (records[index].frames != keys)
+            throw std::runtime_error("Recorded request with timestamp " + std::to_string(keys.front().timestamp) +
+                                     ", ROI index " + std::to_string(keys.front().index) + " has " +
+                                     std::to_string(records[index].frames.size()) +
+                                     " frames which do not match frames of replayed request");
+    }
+    next_record = (index + 1) % records.size();
+    return records[index].blobs;
+}
+
+void MockImageInference::PreProcess(BatchRequest &request, const Image &image) {
+    const size_t plane_size = width * height;
+    Image dst = Image();
+    dst.type = MemoryType::SYSTEM;
+    dst.format = FourCC::FOURCC_RGBP;
+    dst.width = width;
+    dst.height = height;
+    for (size_t i = 0; i < 3; i++) {
+        dst.planes[i] = &request.input[(request.buffers.size() * 3 + i) * plane_size];
+        dst.stride[i] = width;
+    }
+    try {
+        pre_processor->Convert(image, dst);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error("Failed while software frame preprocessing"));
+    }
+}
+
+void MockImageInference::SubmitImage(const Image &image, IFramePtr user_data,
+                                     const std::map<std::string, InputLayerDesc::Ptr> & /*input_preprocessors*/) {
+    GVA_DEBUG(__FUNCTION__);
+    std::unique_ptr<BatchRequest> request;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++requests_processing;
+        if (partial_request) {
+            request = std::move(partial_request);
+        } else {
+            request_processed.wait(lock, [this] { return !free_requests.empty(); });
+            request = std::move(free_requests.back());
+            free_requests.pop_back();
+        }
+    }
+
+    if (pre_processor)
+        PreProcess(*request, image);
+    request->buffers.push_back(user_data);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (request->buffers.size() >= batch_size) {
+        queue.push_back(std::move(request));
+        request_submitted.notify_one();
+    } else if (!partial_request) {
+        partial_request = std::move(request);
+    } else {
+        // another thread already holds partial batch, this one goes back to the pool and is completed later
+        free_requests.push_back(std::move(request));
+    }
+}
+
+void MockImageInference::WorkingFunction() {
+    for (;;) {
+        std::unique_ptr<BatchRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            request_submitted.wait(lock, [this] { return stop || !queue.empty(); });
+            if (queue.empty())
+                return;
+            request = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        std::this_thread::sleep_for(latency);
+        const size_t buffer_size = request->buffers.size();
+        try {
+            callback(blob_record ? NextRecord(request->buffers) : output_blobs, request->buffers);
+        } catch (const std::exception &e) {
+            std::string msg = "Failed in inference request completion callback:\n" + Utils::createNestedErrorMsg(e);
+            GVA_ERROR(msg.c_str());
+            handleError(request->buffers);
+        }
+        request->buffers.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        free_requests.push_back(std::move(request));
+        requests_processing -= buffer_size;
+        request_processed.notify_all();
+    }
+}
+
+const std::string &MockImageInference::GetModelName() const {
+    return model_name;
+}
+
+void MockImageInference::GetModelImageInputInfo(size_t &width, size_t &height, size_t &batch_size,
+                                                int &format) const {
+    width = this->width;
+    height = this->height;
+    batch_size = this->batch_size;
+    format = FourCC::FOURCC_RGBP;
+}
+
+void MockImageInference::WarmUp(const Image &image) {
+    if (!pre_processor)
+        return;
+    // called before first SubmitImage, so all requests are idle
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &request : free_requests)
+        PreProcess(*request, image);
+}
+
+bool MockImageInference::IsQueueFull() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return free_requests.empty() && !partial_request;
+}
+
+void MockImageInference::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (requests_processing != 0) {
+        if (partial_request)
+            queue.push_back(std::move(partial_request));
+        for (auto it = free_requests.begin(); it != free_requests.end();) {
+            if ((*it)->buffers.empty()) {
+                ++it;
+                continue;
+            }
+            queue.push_back(std::move(*it));
+            it = free_requests.erase(it);
+        }
+        request_submitted.notify_all();
+        request_processed.wait_for(lock, std::chrono::seconds(1), [this] { return requests_processing == 0; });
+    }
+}
+
+void MockImageInference::Close() {
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    request_submitted.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+    workers.clear();
+}
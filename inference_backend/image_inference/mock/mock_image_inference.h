@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/image_inference.h"
+#include "inference_backend/pre_proc.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BlobRecord {
+class Reader;
+}
+
+// Inference backend selected with device=MOCK, so pipeline can be benchmarked without inference device and model.
+// Model file is either JSON description of the network: size of image input, latency of single inference request and
+// output layers filled with synthetic or recorded data (see samples/benchmark/mock for examples), or output blobs
+// recorded from OpenVINO inference with GVA_BLOB_RECORD_DIR set, which are replayed without latency
+class MockImageInference : public InferenceBackend::ImageInference {
+  public:
+    MockImageInference(const std::string &model,
+                       const std::map<std::string, std::map<std::string, std::string>> &config,
+                       CallbackFunc callback, ErrorHandlingFunc error_handler);
+
+    ~MockImageInference() override;
+
+    void SubmitImage(const InferenceBackend::Image &image, IFramePtr user_data,
+                     const std::map<std::string, InferenceBackend::InputLayerDesc::Ptr> &input_preprocessors) override;
+
+    const std::string &GetModelName() const override;
+
+    void GetModelImageInputInfo(size_t &width, size_t &height, size_t &batch_size, int &format) const override;
+
+    void WarmUp(const InferenceBackend::Image &image) override;
+
+    bool IsQueueFull() override;
+
+    void Flush() override;
+
+    void Close() override;
+
+  private:
+    struct BatchRequest {
+        std::vector<IFramePtr> buffers;
+        std::vector<uint8_t> input; // planar RGB images of the batch, written only if pre-processing is enabled
+    };
+
+    void ReadDescription(const std::string &model);
+    void ReadRecord(const std::string &model);
+    const std::map<std::string, InferenceBackend::OutputBlob::Ptr> &NextRecord(const std::vector<IFramePtr> &frames);
+    void PreProcess(BatchRequest &request, const InferenceBackend::Image &image);
+    void WorkingFunction();
+
+    CallbackFunc callback;
+    ErrorHandlingFunc handleError;
+
+    std::string model_name;
+    size_t width;
+    size_t height;
+    const size_t batch_size;
+    size_t nireq;
+    std::chrono::microseconds latency;
+    // blobs are generated once and shared by all callbacks, consumers only read them
+    std::map<std::string, InferenceBackend::OutputBlob::Ptr> output_blobs;
+    std::unique_ptr<BlobRecord::Reader> blob_record;
+    // indexes of records by timestamp and ROI index of their first frame
+    std::map<std::pair<uint64_t, uint64_t>, std::deque<size_t>> records_by_key;
+    size_t next_record;
+    std::unique_ptr<InferenceBackend::PreProc> pre_processor;
+
+    std::mutex mutex;
+    std::condition_variable request_submitted;
+    std::condition_variable request_processed;
+    std::unique_ptr<BatchRequest> partial_request;
+    std::vector<std::unique_ptr<BatchRequest>> free_requests;
+    std::deque<std::unique_ptr<BatchRequest>> queue;
+    size_t requests_processing; // number of frames submitted and not completed yet
+    bool stop;
+    std::vector<std::thread> workers;
+};
@@ -9,7 +9,18 @@
 #include "inference_backend/logger.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 
 using namespace InferenceBackend;
 
@@ -69,6 +80,173 @@ inline std::string fileNameNoExt(const std::string &filepath) {
     return filepath.substr(0, pos);
 }
 
+// On-disk cache of compiled (exported) networks, enabled by GVA_MODEL_CACHE_DIR environment variable.
+// GVA_MODEL_CACHE_SIZE_MB limits total size of cached blobs, least recently used blobs are removed first
+class CompiledNetworkCache {
+  public:
+    static CompiledNetworkCache &instance() {
+        static CompiledNetworkCache cache;
+        return cache;
+    }
+
+    bool enabled() const {
+        return !dir.empty();
+    }
+
+    std::string key(const InferenceEngine::CNNNetwork &network, const std::string &model_xml,
+                    const std::map<std::string, std::string> &base_config,
+                    const std::map<std::string, std::string> &inference_config) const {
+        uint64_t hash = FNV_OFFSET;
+        hash = hashFile(model_xml, hash);
+        hash = hashFile(fileNameNoExt(model_xml) + ".bin", hash);
+
+        std::ostringstream description;
+        const InferenceEngine::Version *version = InferenceEngine::GetInferenceEngineVersion();
+        if (version && version->buildNumber)
+            description << version->buildNumber << ';';
+        for (const char *config_key :
+             {KEY_DEVICE, KEY_RESHAPE, KEY_BATCH_SIZE, KEY_RESHAPE_WIDTH, KEY_RESHAPE_HEIGHT, KEY_CPU_EXTENSION,
+              KEY_GPU_EXTENSION, KEY_VPU_EXTENSION, KEY_PRE_PROCESSOR_TYPE, KEY_IMAGE_FORMAT}) {
+            auto it = base_config.find(config_key);
+            if (it != base_config.end())
+                description << config_key << '=' << it->second << ';';
+        }
+        for (const auto &item : inference_config)
+            description << item.first << '=' << item.second << ';';
+        // input precisions are set by builder before compilation
+        for (const auto &input : network.getInputsInfo())
+            description << input.first << ':' << input.second->getPrecision().name() << ';';
+        const std::string description_str = description.str();
+        hash = hashBytes(description_str.data(), description_str.size(), hash);
+
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+        return name;
+    }
+
+    bool import(const std::string &key, InferenceEngine::Core &core, const std::string &device,
+                const std::map<std::string, std::string> &inference_config,
+                InferenceEngine::ExecutableNetwork &executable_network) {
+        const std::string path = blobPath(key);
+        if (!Utils::fileExists(path))
+            return false;
+        try {
+            executable_network = core.ImportNetwork(path, device, inference_config);
+        } catch (const std::exception &e) {
+            const std::string msg = "Failed to import cached network '" + path + "', it will be recompiled:\n" +
+                                    Utils::createNestedErrorMsg(e);
+            GVA_WARNING(msg.c_str());
+            std::remove(path.c_str());
+            return false;
+        }
+        utime(path.c_str(), nullptr); // mark as recently used for eviction
+        return true;
+    }
+
+    void store(const std::string &key, InferenceEngine::ExecutableNetwork &executable_network) {
+        const std::string path = blobPath(key);
+        std::ostringstream tmp_path;
+        tmp_path << path << ".tmp." << getpid() << '.' << std::this_thread::get_id();
+        try {
+            executable_network.Export(tmp_path.str());
+        } catch (const std::exception &e) {
+            // not all plugins support export
+            const std::string msg = "Compiled network is not cached: " + Utils::createNestedErrorMsg(e);
+            GVA_WARNING(msg.c_str());
+            std::remove(tmp_path.str().c_str());
+            return;
+        }
+        // rename is atomic, so concurrent readers see either no blob or complete one
+        if (std::rename(tmp_path.str().c_str(), path.c_str()) != 0) {
+            std::remove(tmp_path.str().c_str());
+            return;
+        }
+        evict();
+    }
+
+  private:
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    CompiledNetworkCache() : max_size(1024ULL * 1024 * 1024) {
+        const char *cache_dir = std::getenv("GVA_MODEL_CACHE_DIR");
+        if (!cache_dir || !*cache_dir)
+            return;
+        mkdir(cache_dir, 0755);
+        struct stat st;
+        if (stat(cache_dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            const std::string msg = "Model cache directory '" + std::string(cache_dir) + "' is not accessible";
+            GVA_WARNING(msg.c_str());
+            return;
+        }
+        dir = cache_dir;
+        const char *size_mb = std::getenv("GVA_MODEL_CACHE_SIZE_MB");
+        if (size_mb && *size_mb)
+            max_size = std::strtoull(size_mb, nullptr, 10) * 1024 * 1024;
+    }
+
+    std::string blobPath(const std::string &key) const {
+        return dir + "/" + key + ".blob";
+    }
+
+    static uint64_t hashBytes(const char *data, size_t size, uint64_t hash) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    static uint64_t hashFile(const std::string &path, uint64_t hash) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Failed to read model file '" + path + "'");
+        std::vector<char> chunk(1 << 20);
+        while (file) {
+            file.read(chunk.data(), chunk.size());
+            hash = hashBytes(chunk.data(), static_cast<size_t>(file.gcount()), hash);
+        }
+        return hash;
+    }
+
+    void evict() {
+        struct Entry {
+            std::string path;
+            time_t mtime;
+            uint64_t size;
+        };
+        std::vector<Entry> entries;
+        uint64_t total_size = 0;
+
+        DIR *directory = opendir(dir.c_str());
+        if (!directory)
+            return;
+        const std::string suffix = ".blob";
+        while (struct dirent *entry = readdir(directory)) {
+            const std::string name = entry->d_name;
+            if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix))
+                continue;
+            struct stat st;
+            const std::string path = dir + "/" + name;
+            if (stat(path.c_str(), &st) != 0)
+                continue;
+            entries.push_back({path, st.st_mtime, static_cast<uint64_t>(st.st_size)});
+            total_size += st.st_size;
+        }
+        closedir(directory);
+
+        std::sort(entries.begin(), entries.end(), [](const Entry &l, const Entry &r) { return l.mtime < r.mtime; });
+        // keep the most recent blob even if it alone exceeds the limit
+        for (size_t i = 0; total_size > max_size && i + 1 < entries.size(); i++) {
+            if (std::remove(entries[i].path.c_str()) == 0)
+                total_size -= entries[i].size;
+        }
+    }
+
+    std::string dir;
+    uint64_t max_size;
+};
+
 } // namespace
 
 bool ModelLoader::is_ir_model(const std::string &model_path) {
@@ -103,14 +281,42 @@ std::string IrModelLoader::name(const InferenceEngine::CNNNetwork &network) {
     return network.getName();
 }
 
-InferenceEngine::ExecutableNetwork IrModelLoader::import(InferenceEngine::CNNNetwork &network, const std::string &,
-                                                         InferenceEngine::Core &core,
+InferenceEngine::ExecutableNetwork IrModelLoader::import(InferenceEngine::CNNNetwork &network,
+                                                         const std::string &model, InferenceEngine::Core &core,
                                                          const std::map<std::string, std::string> &base_config,
                                                          const std::map<std::string, std::string> &inference_config) {
     if (base_config.count(KEY_DEVICE) == 0)
         throw std::runtime_error("Device does not specified");
     const std::string &device = base_config.at(KEY_DEVICE);
-    return core.LoadNetwork(network, device, inference_config);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed_ms = [&start]() {
+        return std::to_string(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    };
+
+    // resize and color conversion of Inference Engine pre-processing are set on network inputs and are not restored
+    // by ImportNetwork, so such networks are always compiled
+    auto pre_processor_type = base_config.find(KEY_PRE_PROCESSOR_TYPE);
+    const bool ie_pre_processing = pre_processor_type != base_config.end() && pre_processor_type->second == "ie";
+
+    CompiledNetworkCache &cache = CompiledNetworkCache::instance();
+    if (!cache.enabled() || model.empty() || ie_pre_processing)
+        return core.LoadNetwork(network, device, inference_config);
+
+    const std::string key = cache.key(network, model, base_config, inference_config);
+    InferenceEngine::ExecutableNetwork executable_network;
+    if (cache.import(key, core, device, inference_config, executable_network)) {
+        const std::string msg = "Network '" + network.getName() + "' imported from cache in " + elapsed_ms() + " ms";
+        GVA_INFO(msg.c_str());
+        return executable_network;
+    }
+
+    executable_network = core.LoadNetwork(network, device, inference_config);
+    const std::string msg = "Network '" + network.getName() + "' compiled in " + elapsed_ms() + " ms (cache miss)";
+    GVA_INFO(msg.c_str());
+    cache.store(key, executable_network);
+    return executable_network;
 }
 
 InferenceEngine::CNNNetwork CompiledModelLoader::load(InferenceEngine::Core &, const std::string &,
@@ -32,7 +32,8 @@ struct IrModelLoader : ModelLoader {
 
     std::string name(const InferenceEngine::CNNNetwork &network) override;
 
-    InferenceEngine::ExecutableNetwork import(InferenceEngine::CNNNetwork &network, const std::string &,
+    // Compiled network is exported to and imported from GVA_MODEL_CACHE_DIR if this environment variable is set
+    InferenceEngine::ExecutableNetwork import(InferenceEngine::CNNNetwork &network, const std::string &model,
                                               InferenceEngine::Core &core,
                                               const std::map<std::string, std::string> &base_config,
                                               const std::map<std::string, std::string> &inference_config) override;
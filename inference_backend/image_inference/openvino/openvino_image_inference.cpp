@@ -6,6 +6,7 @@
 
 #include "openvino_image_inference.h"
 
+#include "blob_record.h"
 #include "inference_backend/logger.h"
 #include "inference_backend/pre_proc.h"
 #include "inference_backend/safe_arithmetic.h"
@@ -15,10 +16,12 @@
 #include "wrap_image.h"
 
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <ie_compound_blob.h>
 #include <ie_core.hpp>
 #include <inference_engine.hpp>
+#include <limits>
 #include <stdio.h>
 #include <thread>
 
@@ -27,6 +30,9 @@ using namespace InferenceBackend;
 
 namespace {
 
+// value of partial_request when there is no partially filled batch
+constexpr size_t NO_REQUEST = std::numeric_limits<size_t>::max();
+
 InferenceEngine::InputsDataMap modelInputsInfo(InferenceEngine::ExecutableNetwork &executable_network);
 
 IE::ColorFormat FormatNameToIEColorFormat(const std::string &format);
@@ -155,6 +161,38 @@ allocateBlob(const InferenceEngine::TensorDesc &tensor_desc, Allocator *allocato
     }
 }
 
+template <typename T>
+InferenceEngine::Blob::Ptr CopyBlobData(const InferenceEngine::Blob::Ptr &blob) {
+    auto copy = InferenceEngine::make_shared_blob<T>(blob->getTensorDesc());
+    copy->allocate();
+    std::memcpy(copy->buffer().template as<void *>(), blob->cbuffer().template as<const void *>(), blob->byteSize());
+    return copy;
+}
+
+// Output blobs are copied out of infer request, so request can be returned to the pool while results are still
+// being processed
+InferenceEngine::Blob::Ptr CopyBlob(const InferenceEngine::Blob::Ptr &blob) {
+    ITT_TASK(__FUNCTION__);
+    switch (blob->getTensorDesc().getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        return CopyBlobData<float>(blob);
+    case InferenceEngine::Precision::FP16:
+    case InferenceEngine::Precision::I16:
+        return CopyBlobData<int16_t>(blob);
+    case InferenceEngine::Precision::U16:
+        return CopyBlobData<uint16_t>(blob);
+    case InferenceEngine::Precision::I32:
+        return CopyBlobData<int32_t>(blob);
+    case InferenceEngine::Precision::U8:
+        return CopyBlobData<uint8_t>(blob);
+    case InferenceEngine::Precision::I8:
+        return CopyBlobData<int8_t>(blob);
+    default:
+        throw std::invalid_argument("Failed to copy Blob: InferenceEngine::Precision " +
+                                    std::to_string(blob->getTensorDesc().getPrecision()) + " is not supported");
+    }
+}
+
 size_t optimalNireq(const InferenceEngine::ExecutableNetwork &executable_network) {
     size_t nireq = 0;
     try {
@@ -225,7 +263,8 @@ struct EntityBuilder {
         return loader->load(core, model, base_config);
     };
 
-    virtual std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string>
+    virtual std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string,
+                       InferenceEngine::InputInfo::Ptr>
     createPreProcAndExecutableNetwork(InferenceEngine::CNNNetwork &network, InferenceEngine::Core &core,
                                       const std::string &model) {
         addExtension(core, base_config);
@@ -237,7 +276,8 @@ struct EntityBuilder {
     }
 
   private:
-    virtual std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string>
+    virtual std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string,
+                       InferenceEngine::InputInfo::Ptr>
     createPreProcAndExecutableNetwork_impl(InferenceEngine::CNNNetwork &network, InferenceEngine::Core &core,
                                            const std::string &model) = 0;
 
@@ -286,19 +326,20 @@ struct IrBuilder : EntityBuilder {
         }
     }
 
-    std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string>
+    std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string,
+               InferenceEngine::InputInfo::Ptr>
     createPreProcAndExecutableNetwork_impl(InferenceEngine::CNNNetwork &network, InferenceEngine::Core &core,
                                            const std::string &model) override {
         auto inputs_info = network.getInputsInfo();
         std::string image_input_name;
         configureNetworkLayers(inputs_info, image_input_name);
+        InferenceEngine::InputInfo::Ptr image_input = inputs_info[image_input_name];
         std::unique_ptr<InferenceBackend::PreProc> pre_processor =
-            createPreProcessor(inputs_info[image_input_name], batch_size, base_config);
+            createPreProcessor(image_input, batch_size, base_config);
         InferenceEngine::ExecutableNetwork executable_network =
             loader->import(network, model, core, base_config, inference_config);
-        return std::make_tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork,
-                               std::string>(std::move(pre_processor), std::move(executable_network),
-                                            std::move(image_input_name));
+        return std::make_tuple(std::move(pre_processor), std::move(executable_network), std::move(image_input_name),
+                               std::move(image_input));
     }
 };
 
@@ -308,7 +349,8 @@ struct CompiledBuilder : EntityBuilder {
     }
 
   private:
-    std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string>
+    std::tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork, std::string,
+               InferenceEngine::InputInfo::Ptr>
     createPreProcAndExecutableNetwork_impl(InferenceEngine::CNNNetwork &network, InferenceEngine::Core &core,
                                            const std::string &model) override {
         InferenceEngine::ExecutableNetwork executable_network =
@@ -321,9 +363,8 @@ struct CompiledBuilder : EntityBuilder {
         std::string image_input_name = info->first;
         std::unique_ptr<InferenceBackend::PreProc> pre_processor =
             createPreProcessor(image_input, batch_size, base_config);
-        return std::make_tuple<std::unique_ptr<InferenceBackend::PreProc>, InferenceEngine::ExecutableNetwork,
-                               std::string>(std::move(pre_processor), std::move(executable_network),
-                                            std::move(image_input_name));
+        return std::make_tuple(std::move(pre_processor), std::move(executable_network), std::move(image_input_name),
+                               std::move(image_input));
     }
 };
 
@@ -335,6 +376,79 @@ class GvaErrorListener : public InferenceEngine::IErrorListener {
 
 } // namespace
 
+// Compiled network shared by all instances created with the same model and configuration, so device memory and
+// weights are allocated once per model rather than once per element. Every instance creates its own infer requests
+struct OpenVINOImageInference::SharedNetwork {
+    std::mutex init_mutex;
+    bool initialized = false;
+
+    InferenceEngine::Core core;
+    InferenceEngine::ExecutableNetwork executable_network;
+    InferenceEngine::InputInfo::Ptr image_input;
+    std::string model_name;
+    std::string image_layer;
+};
+
+std::shared_ptr<OpenVINOImageInference::SharedNetwork>
+OpenVINOImageInference::AcquireNetwork(const std::string &model,
+                                       const std::map<std::string, std::map<std::string, std::string>> &config) {
+    // number of requests is per instance and does not affect compiled network
+    std::string key = model;
+    for (const auto &section : config) {
+        for (const auto &item : section.second) {
+            if (section.first == KEY_BASE && (item.first == KEY_NIREQ || item.first == KEY_NIREQ_MAX))
+                continue;
+            key += ";" + section.first + "/" + item.first + "=" + item.second;
+        }
+    }
+
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<SharedNetwork>> registry;
+
+    std::shared_ptr<SharedNetwork> network;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        network = registry[key].lock();
+        if (!network) {
+            network = std::make_shared<SharedNetwork>();
+            registry[key] = network;
+        }
+        // drop entries of released networks
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    // network is loaded outside of registry lock, so different models are loaded concurrently while instances
+    // requesting same model wait for the first one
+    std::lock_guard<std::mutex> lock(network->init_mutex);
+    if (network->initialized) {
+        const std::string msg = "Sharing compiled network '" + network->model_name + "' between elements";
+        GVA_INFO(msg.c_str());
+        return network;
+    }
+
+    std::unique_ptr<EntityBuilder> builder = ModelLoader::is_ir_model(model)
+                                                 ? std::unique_ptr<EntityBuilder>(new IrBuilder(config))
+                                                 : std::unique_ptr<EntityBuilder>(new CompiledBuilder(config));
+    if (not builder)
+        throw std::runtime_error("Failed to create DL model loader");
+    InferenceEngine::CNNNetwork cnn_network = builder->createNetwork(network->core, model);
+    network->model_name = builder->getNetworkName(cnn_network);
+
+    static GvaErrorListener listner;
+    network->core.SetLogCallback(listner);
+
+    std::unique_ptr<InferenceBackend::PreProc> pre_processor;
+    std::tie(pre_processor, network->executable_network, network->image_layer, network->image_input) =
+        builder->createPreProcAndExecutableNetwork(cnn_network, network->core, model);
+    network->initialized = true;
+    return network;
+}
+
 OpenVINOImageInference::~OpenVINOImageInference() {
     GVA_DEBUG("Image Inference destruct");
     Close();
@@ -356,9 +470,11 @@ void OpenVINOImageInference::setCompletionCallback(std::shared_ptr<BatchRequest>
             }
 
             batch_request->buffers.clear();
-            this->freeRequests.push(batch_request);
+            this->freeRequests->push(batch_request->index);
             this->requests_processing_ -= buffer_size;
             this->request_processed_.notify_all();
+            if (this->autotuner)
+                this->TuneRequests();
         } catch (const std::exception &e) {
             std::string msg = "Failed in inference request completion callback:\n" + Utils::createNestedErrorMsg(e);
             GVA_ERROR(msg.c_str());
@@ -385,25 +501,19 @@ OpenVINOImageInference::OpenVINOImageInference(const std::string &model,
                                                const std::map<std::string, std::map<std::string, std::string>> &config,
                                                Allocator *allocator, CallbackFunc callback,
                                                ErrorHandlingFunc error_handler)
-    : allocator(allocator), batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))), requests_processing_(0U) {
+    : allocator(allocator), batch_size(std::stoi(config.at(KEY_BASE).at(KEY_BATCH_SIZE))),
+      partial_request(NO_REQUEST), requests_processing_(0U) {
 
     GVA_DEBUG("OpenVINOImageInference constructor");
 
     try {
-        std::unique_ptr<EntityBuilder> builder = ModelLoader::is_ir_model(model)
-                                                     ? std::unique_ptr<EntityBuilder>(new IrBuilder(config))
-                                                     : std::unique_ptr<EntityBuilder>(new CompiledBuilder(config));
-        if (not builder)
-            throw std::runtime_error("Failed to create DL model loader");
-        InferenceEngine::CNNNetwork network = builder->createNetwork(core, model);
-        model_name = builder->getNetworkName(network);
-
-        static GvaErrorListener listner;
-        core.SetLogCallback(listner);
-
-        InferenceEngine::ExecutableNetwork executable_network;
-        std::tie(pre_processor, executable_network, image_layer) =
-            builder->createPreProcAndExecutableNetwork(network, core, model);
+        network = AcquireNetwork(model, config);
+        model_name = network->model_name;
+        image_layer = network->image_layer;
+        InferenceEngine::ExecutableNetwork &executable_network = network->executable_network;
+        // pre-processor keeps per-instance state, so it is not shared along with network
+        if (network->image_input)
+            pre_processor = createPreProcessor(network->image_input, batch_size, config.at(KEY_BASE));
 
         inputs = executable_network.GetInputsInfo();
         outputs = executable_network.GetOutputsInfo();
@@ -420,15 +530,41 @@ OpenVINOImageInference::OpenVINOImageInference(const std::string &model,
         if (nireq == 0) {
             nireq = optimalNireq(executable_network);
         }
+        // with nireq-max set, all requests are created upfront and autotuner activates part of them
+        const int nireq_max = base_config.count(KEY_NIREQ_MAX) ? std::stoi(base_config.at(KEY_NIREQ_MAX)) : 0;
+        if (nireq_max > 0) {
+            autotuner.reset(new RequestAutotuner(1, std::max(nireq, nireq_max), nireq));
+            std::string msg = "Adaptive number of inference requests: initial=" + std::to_string(nireq) +
+                              ", max=" + std::to_string(std::max(nireq, nireq_max));
+            GVA_INFO(msg.c_str());
+        }
 
-        for (int i = 0; i < nireq; i++) {
+        const size_t total_nireq = std::max(nireq, nireq_max);
+        freeRequests.reset(new RequestPool(total_nireq));
+        for (size_t i = 0; i < total_nireq; i++) {
             std::shared_ptr<BatchRequest> batch_request = std::make_shared<BatchRequest>();
+            batch_request->index = i;
             batch_request->infer_request = executable_network.CreateInferRequestPtr();
             setCompletionCallback(batch_request);
             if (allocator) {
                 setBlobsToInferenceRequest(layers, batch_request, allocator);
             }
-            freeRequests.push(batch_request);
+            requests.push_back(batch_request);
+            if (i < static_cast<size_t>(nireq))
+                freeRequests->push(i);
+            else
+                parked_requests.push_back(i);
+        }
+
+        const std::string record_path = BlobRecord::RecordPathFromEnvironment(model_name);
+        if (!record_path.empty()) {
+            size_t width = 0, height = 0, input_batch_size = 0;
+            int format = 0;
+            if (inputs.count(image_layer))
+                GetModelImageInputInfo(width, height, input_batch_size, format);
+            recorder.reset(new BlobRecord::Recorder(record_path, model_name, width, height, batch_size));
+            const std::string msg = "Model '" + model_name + "': recording output blobs to " + record_path;
+            GVA_INFO(msg.c_str());
         }
 
         initialized = true;
@@ -440,7 +576,7 @@ OpenVINOImageInference::OpenVINOImageInference(const std::string &model,
 }
 
 bool OpenVINOImageInference::IsQueueFull() {
-    return freeRequests.empty();
+    return freeRequests->empty() && partial_request.load(std::memory_order_relaxed) == NO_REQUEST;
 }
 
 namespace {
@@ -493,8 +629,8 @@ Image MapBlobBufferToImage(IE::Blob::Ptr blob, size_t batch_index) {
 }
 } // namespace
 
-void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                                                   const Image &src_img) {
+void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name,
+                                                   const std::shared_ptr<BatchRequest> &request, const Image &src_img) {
     ITT_TASK("SubmitImageProcessing");
     if (not request or not request->infer_request)
         throw std::invalid_argument("InferRequest is absent");
@@ -510,8 +646,8 @@ void OpenVINOImageInference::SubmitImageProcessing(const std::string &input_name
     }
 }
 
-void OpenVINOImageInference::BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
-                                                   const Image &src_img) {
+void OpenVINOImageInference::BypassImageProcessing(const std::string &input_name,
+                                                   const std::shared_ptr<BatchRequest> &request, const Image &src_img) {
     ITT_TASK("BypassImage");
     if (not request or not request->infer_request)
         throw std::invalid_argument("InferRequest is absent");
@@ -546,7 +682,17 @@ void OpenVINOImageInference::SubmitImage(const Image &image, IFramePtr user_data
     ITT_TASK(__FUNCTION__);
 
     ++requests_processing_;
-    auto request = freeRequests.pop();
+    size_t index = partial_request.exchange(NO_REQUEST);
+    if (index == NO_REQUEST) {
+        if (autotuner) {
+            const auto wait_start = std::chrono::steady_clock::now();
+            index = freeRequests->pop();
+            autotuner->OnSubmit(std::chrono::steady_clock::now() - wait_start);
+        } else {
+            index = freeRequests->pop();
+        }
+    }
+    std::shared_ptr<BatchRequest> &request = requests[index];
 
     if (pre_processor.get()) {
         SubmitImageProcessing(image_layer, request, image);
@@ -560,9 +706,70 @@ void OpenVINOImageInference::SubmitImage(const Image &image, IFramePtr user_data
 
     // start inference asynchronously if enough buffers for batching
     if (request->buffers.size() >= (size_t)batch_size) {
+        // frames are identified by PTS, as in markers of inference elements
+        for (const IFramePtr &frame : request->buffers)
+            LATENCY_TRACE_INSTANT("StartAsync", frame ? frame->GetTimestamp() : NO_TIMESTAMP);
         request->infer_request->StartAsync();
     } else {
-        freeRequests.push_front(request);
+        // if another thread already holds partial batch, this one goes back to the pool and is completed later
+        size_t expected = NO_REQUEST;
+        if (!partial_request.compare_exchange_strong(expected, index))
+            freeRequests->push(index);
+    }
+}
+
+void OpenVINOImageInference::TuneRequests() {
+    RequestAutotuner::Report report;
+    const RequestAutotuner::Decision decision = autotuner->OnCompleted(freeRequests->size(), report);
+    if (decision == RequestAutotuner::Decision::KEEP)
+        return;
+
+    std::lock_guard<std::mutex> lock(parked_mutex);
+    if (decision == RequestAutotuner::Decision::GROW) {
+        if (parked_requests.empty()) {
+            autotuner->Revert(decision);
+            return;
+        }
+        freeRequests->push(parked_requests.back());
+        parked_requests.pop_back();
+    } else {
+        size_t index;
+        if (!freeRequests->try_pop(index)) {
+            autotuner->Revert(decision);
+            return;
+        }
+        if (!requests[index]->buffers.empty()) { // partially filled batch returned to the pool, keep it active
+            freeRequests->push(index);
+            autotuner->Revert(decision);
+            return;
+        }
+        parked_requests.push_back(index);
+    }
+
+    char msg[256];
+    snprintf(msg, sizeof(msg),
+             "Model '%s': %s inference requests to %zu (throughput %.1f req/s, wait for free request %.2f ms), "
+             "recommended throughput streams: %zu",
+             model_name.c_str(), decision == RequestAutotuner::Decision::GROW ? "increased" : "decreased",
+             report.active, report.throughput, report.avg_wait_ms, report.recommended_streams);
+    GVA_INFO(msg);
+}
+
+void OpenVINOImageInference::WarmUp(const Image &image) {
+    ITT_TASK(__FUNCTION__);
+    // called before first SubmitImage, so all requests including parked ones are idle
+    for (auto &request : requests) {
+        if (pre_processor.get()) {
+            SubmitImageProcessing(image_layer, request, image);
+        } else {
+            BypassImageProcessing(image_layer, request, image);
+        }
+        try {
+            // synchronous inference does not invoke completion callback
+            request->infer_request->Infer();
+        } catch (const std::exception &e) {
+            std::throw_with_nested(std::runtime_error("Failed to warm up inference requests"));
+        }
     }
 }
 
@@ -601,11 +808,13 @@ void OpenVINOImageInference::GetModelImageInputInfo(size_t &width, size_t &heigh
 void OpenVINOImageInference::Flush() {
     std::unique_lock<std::mutex> lk(mutex_);
     while (requests_processing_ != 0) {
-        auto request = freeRequests.pop();
-        if (request->buffers.size() > 0) {
-            request->infer_request->StartAsync();
+        size_t index = partial_request.exchange(NO_REQUEST);
+        if (index == NO_REQUEST)
+            index = freeRequests->pop();
+        if (requests[index]->buffers.size() > 0) {
+            requests[index]->infer_request->StartAsync();
         } else {
-            freeRequests.push(request);
+            freeRequests->push(index);
         }
         request_processed_.wait_for(lk, std::chrono::seconds(1), [this] { return requests_processing_ == 0; });
     }
@@ -613,8 +822,8 @@ void OpenVINOImageInference::Flush() {
 
 void OpenVINOImageInference::Close() {
     Flush();
-    while (!freeRequests.empty()) {
-        auto req = freeRequests.pop();
+    std::lock_guard<std::mutex> lock(parked_mutex);
+    for (auto &req : requests) {
         // as earlier set callbacks own shared pointers we need to set lambdas with the empty capture lists
         req->infer_request->SetCompletionCallback([] {});
         if (allocator) {
@@ -622,14 +831,35 @@ void OpenVINOImageInference::Close() {
                 allocator->Free(ac);
         }
     }
+    requests.clear();
+    parked_requests.clear();
 }
 
 void OpenVINOImageInference::WorkingFunction(const std::shared_ptr<BatchRequest> &request) {
     GVA_DEBUG(__FUNCTION__);
     std::map<std::string, OutputBlob::Ptr> output_blobs;
+    std::vector<BlobRecord::Recorder::Layer> recorded_layers;
     for (auto output : outputs) {
         const std::string &name = output.first;
-        output_blobs[name] = std::make_shared<OpenvinoOutputBlob>(request->infer_request->GetBlob(name));
+        IE::Blob::Ptr blob = CopyBlob(request->infer_request->GetBlob(name));
+        output_blobs[name] = std::make_shared<OpenvinoOutputBlob>(blob);
+        if (recorder) {
+            const IE::TensorDesc &desc = blob->getTensorDesc();
+            recorded_layers.push_back({name, desc.getDims(), (int)desc.getPrecision(), (int)desc.getLayout(),
+                                       blob->cbuffer().as<const void *>(), blob->byteSize()});
+        }
+    }
+    if (recorder) {
+        std::vector<BlobRecord::FrameKey> frames;
+        for (const IFramePtr &frame : request->buffers)
+            frames.push_back(frame ? BlobRecord::FrameKey{frame->GetTimestamp(), frame->GetIndex()}
+                                   : BlobRecord::FrameKey{NO_TIMESTAMP, 0});
+        try {
+            recorder->Write(frames, recorded_layers);
+        } catch (const std::exception &e) {
+            std::string msg = "Failed to record output blobs:\n" + Utils::createNestedErrorMsg(e);
+            GVA_ERROR(msg.c_str());
+        }
     }
     callback(output_blobs, request->buffers);
 }
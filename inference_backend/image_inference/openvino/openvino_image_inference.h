@@ -13,11 +13,17 @@
 #include <atomic>
 #include <inference_engine.hpp>
 #include <map>
+#include <memory>
 #include <string>
 #include <thread>
 
 #include "config.h"
-#include "safe_queue.h"
+#include "request_autotuner.h"
+#include "request_pool.h"
+
+namespace BlobRecord {
+class Recorder;
+}
 
 class OpenVINOImageInference : public InferenceBackend::ImageInference {
   public:
@@ -38,6 +44,8 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
 
     virtual void GetModelImageInputInfo(size_t &width, size_t &height, size_t &batch_size, int &format) const;
 
+    virtual void WarmUp(const InferenceBackend::Image &image);
+
     virtual bool IsQueueFull();
 
     virtual void Flush();
@@ -48,6 +56,7 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
     bool initialized;
 
     struct BatchRequest {
+        size_t index; // position in 'requests'
         InferenceEngine::InferRequest::Ptr infer_request;
         std::vector<IFramePtr> buffers;
         std::vector<InferenceBackend::Allocator::AllocContext *> alloc_context;
@@ -62,7 +71,8 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
     ErrorHandlingFunc handleError;
 
     // Inference Engine
-    InferenceEngine::Core core;
+    struct SharedNetwork;
+    std::shared_ptr<SharedNetwork> network;
     InferenceEngine::ConstInputsDataMap inputs;
     InferenceEngine::ConstOutputsDataMap outputs;
     std::string model_name;
@@ -70,10 +80,22 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
 
     // Threading
     const int batch_size;
-    SafeQueue<std::shared_ptr<BatchRequest>> freeRequests;
+    // All requests are created in constructor and referred by index afterwards, so taking and returning request does
+    // not touch shared_ptr reference counters
+    std::vector<std::shared_ptr<BatchRequest>> requests;
+    std::unique_ptr<RequestPool> freeRequests;
+    // partially filled batch, taken first by next SubmitImage
+    std::atomic<size_t> partial_request;
+    // requests created up to 'nireq-max' but currently deactivated by autotuner
+    std::vector<size_t> parked_requests;
+    std::mutex parked_mutex;
+    std::unique_ptr<RequestAutotuner> autotuner;
 
     std::unique_ptr<InferenceBackend::PreProc> pre_processor;
 
+    // output blobs are recorded for replay on MOCK device if GVA_BLOB_RECORD_DIR environment variable is set
+    std::unique_ptr<BlobRecord::Recorder> recorder;
+
     std::mutex mutex_;
     std::atomic<unsigned int> requests_processing_;
     std::condition_variable request_processed_;
@@ -82,11 +104,14 @@ class OpenVINOImageInference : public InferenceBackend::ImageInference {
     std::queue<InferenceBackend::OutputBlob> output_blob_pool;
 
   private:
-    void SubmitImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
+    static std::shared_ptr<SharedNetwork>
+    AcquireNetwork(const std::string &model, const std::map<std::string, std::map<std::string, std::string>> &config);
+    void SubmitImageProcessing(const std::string &input_name, const std::shared_ptr<BatchRequest> &request,
                                const InferenceBackend::Image &src_img);
-    void BypassImageProcessing(const std::string &input_name, std::shared_ptr<BatchRequest> request,
+    void BypassImageProcessing(const std::string &input_name, const std::shared_ptr<BatchRequest> &request,
                                const InferenceBackend::Image &src_img);
     void setCompletionCallback(std::shared_ptr<BatchRequest> &batch_request);
+    void TuneRequests();
     void
     ApplyInputPreprocessors(std::shared_ptr<BatchRequest> &request,
                             const std::map<std::string, InferenceBackend::InputLayerDesc::Ptr> &input_preprocessors);
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+// Chooses number of active inference requests online. Submitting thread waiting for a free request means there are
+// too few of them, requests staying free for a whole window means there are too many. Growth is kept only if it
+// raised throughput, otherwise it is reverted and growth is paused for a few windows (hill climbing)
+class RequestAutotuner {
+  public:
+    enum class Decision { KEEP, GROW, SHRINK };
+
+    struct Report {
+        double throughput;          // completed requests per second in last window
+        double avg_wait_ms;         // average time submitting thread waited for a free request
+        size_t active;              // number of active requests after decision
+        size_t recommended_streams; // average number of requests busy at the same time
+    };
+
+    RequestAutotuner(size_t min_active, size_t max_active, size_t initial_active)
+        : min_active(std::max<size_t>(min_active, 1)), max_active(std::max(max_active, this->min_active)),
+          active(std::min(std::max(initial_active, this->min_active), this->max_active)),
+          last_decision(Decision::KEEP), last_throughput(0), cooldown(0) {
+        ResetWindow(Clock::now());
+    }
+
+    size_t Active() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return active;
+    }
+
+    void OnSubmit(std::chrono::nanoseconds wait) {
+        std::lock_guard<std::mutex> lock(mutex);
+        total_wait += wait;
+        submits++;
+    }
+
+    // Called when request is returned to the pool with number of free requests after return. Returns decision at
+    // the end of each window, caller is expected to activate or park one request accordingly
+    Decision OnCompleted(size_t free_requests, Report &report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto now = Clock::now();
+        completed++;
+        const size_t busy = active > free_requests ? active - free_requests : 0;
+        busy_sum += busy;
+        min_free = std::min(min_free, free_requests > 0 ? free_requests - 1 : 0); // except just returned request
+
+        const double window_sec = std::chrono::duration<double>(now - window_start).count();
+        if (window_sec < WINDOW_SEC)
+            return Decision::KEEP;
+
+        const double throughput = completed / window_sec;
+        const double avg_wait_ms =
+            submits ? std::chrono::duration<double, std::milli>(total_wait).count() / submits : 0;
+        Decision decision = Decision::KEEP;
+        if (last_decision == Decision::GROW && throughput < last_throughput * (1 + MIN_GAIN)) {
+            decision = Decision::SHRINK; // extra request did not pay off
+            cooldown = COOLDOWN_WINDOWS;
+        } else if (avg_wait_ms > STARVATION_WAIT_MS && active < max_active && cooldown == 0) {
+            decision = Decision::GROW;
+        } else if (min_free >= 2 && active > min_active) {
+            decision = Decision::SHRINK;
+        }
+        if (cooldown > 0 && decision != Decision::SHRINK)
+            cooldown--;
+
+        if (decision == Decision::GROW)
+            active++;
+        else if (decision == Decision::SHRINK)
+            active--;
+
+        report.throughput = throughput;
+        report.avg_wait_ms = avg_wait_ms;
+        report.active = active;
+        report.recommended_streams = std::max<size_t>(1, (busy_sum + completed / 2) / completed);
+
+        last_decision = decision;
+        last_throughput = throughput;
+        ResetWindow(now);
+        return decision;
+    }
+
+    // Decision could not be applied (e.g. no idle request to park)
+    void Revert(Decision decision) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (decision == Decision::GROW)
+            active--;
+        else if (decision == Decision::SHRINK)
+            active++;
+        last_decision = Decision::KEEP;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double WINDOW_SEC = 1.0;
+    static constexpr double STARVATION_WAIT_MS = 1.0;
+    static constexpr double MIN_GAIN = 0.05;
+    static constexpr int COOLDOWN_WINDOWS = 5;
+
+    void ResetWindow(Clock::time_point now) {
+        window_start = now;
+        total_wait = std::chrono::nanoseconds(0);
+        submits = 0;
+        completed = 0;
+        busy_sum = 0;
+        min_free = max_active;
+    }
+
+    const size_t min_active;
+    const size_t max_active;
+    size_t active;
+    Decision last_decision;
+    double last_throughput;
+    int cooldown;
+
+    Clock::time_point window_start;
+    std::chrono::nanoseconds total_wait;
+    size_t submits;
+    size_t completed;
+    size_t busy_sum;
+    size_t min_free;
+
+    mutable std::mutex mutex;
+};
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include "inference_backend/logger.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Bounded lock-free MPMC queue of request indices (array-based queue with per-cell sequence numbers). Pop spins for a
+// short time and then waits on condition variable, mutex is touched only when queue is empty
+class RequestPool {
+  public:
+    // Capacity is twice the number of requests, so cell reused by push is rarely still being released by slow pop
+    explicit RequestPool(size_t requests_number) : waiters(0) {
+        size_t capacity = 2;
+        while (capacity < 2 * requests_number)
+            capacity <<= 1;
+        mask = capacity - 1;
+        cells.reset(new Cell[capacity]);
+        for (size_t i = 0; i < capacity; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        enqueue_pos.store(0, std::memory_order_relaxed);
+        dequeue_pos.store(0, std::memory_order_relaxed);
+    }
+
+    RequestPool(const RequestPool &) = delete;
+    RequestPool &operator=(const RequestPool &) = delete;
+
+    void push(size_t index) {
+        ITT_TASK("RequestPool::push");
+        // pool never holds more indices than there are requests, so it looks full only while a concurrent pop has
+        // claimed the cell but not released it yet
+        while (!try_push(index))
+            std::this_thread::yield();
+        // pairs with fence in pop(): either waiter sees pushed index or we see the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            condition.notify_one();
+        }
+    }
+
+    bool try_pop(size_t &index) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        index = cell->index;
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t pop() {
+        ITT_TASK("RequestPool::pop");
+        size_t index;
+        for (int i = 0; i < SPIN_COUNT; i++) {
+            if (try_pop(index))
+                return index;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, [this, &index] { return try_pop(index); });
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    // Approximate when called concurrently with push/pop
+    size_t size() const {
+        const size_t enqueued = enqueue_pos.load(std::memory_order_relaxed);
+        const size_t dequeued = dequeue_pos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+  private:
+    static constexpr int SPIN_COUNT = 64;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        size_t index;
+    };
+
+    bool try_push(size_t index) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->index = index;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    // padding keeps positions updated by producers and by consumers in different cache lines
+    char pad0[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueue_pos;
+    char pad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_pos;
+    char pad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<int> waiters;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
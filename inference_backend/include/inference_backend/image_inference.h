@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -24,9 +25,20 @@ class ImageInference {
   public:
     using Ptr = std::shared_ptr<ImageInference>;
 
+    static constexpr uint64_t NO_TIMESTAMP = UINT64_MAX;
+
     // Application can derive and put object instance into inference queue, see last parameter in Submit* functions
     struct IFrameBase {
         virtual ~IFrameBase() = default;
+        // Presentation timestamp of the frame, identifies frames in recorded output blobs
+        virtual uint64_t GetTimestamp() const {
+            return NO_TIMESTAMP;
+        }
+        // Position among requests submitted for the same frame (ROI or tile number), together with timestamp
+        // identifies request in recorded output blobs
+        virtual uint64_t GetIndex() const {
+            return 0;
+        }
     };
 
     typedef std::shared_ptr<IFrameBase> IFramePtr;
@@ -44,6 +56,10 @@ class ImageInference {
     virtual const std::string &GetModelName() const = 0;
     virtual void GetModelImageInputInfo(size_t &width, size_t &height, size_t &batch_size, int &format) const = 0;
 
+    // Runs image through pre-processing and every inference request synchronously, results are discarded.
+    // Must be called before first SubmitImage
+    virtual void WarmUp(const Image &image) = 0;
+
     virtual bool IsQueueFull() = 0;
     virtual void Flush() = 0;
     virtual void Close() = 0;
@@ -98,6 +114,7 @@ __DECLARE_CONFIG_KEY(LAYER_PRECISION);
 __DECLARE_CONFIG_KEY(FORMAT);
 __DECLARE_CONFIG_KEY(DEVICE);
 __DECLARE_CONFIG_KEY(NIREQ);
+__DECLARE_CONFIG_KEY(NIREQ_MAX); // upper bound for adaptive number of inference requests, 0 disables adaptation
 __DECLARE_CONFIG_KEY(CPU_EXTENSION);          // library with implementation of custom layers
 __DECLARE_CONFIG_KEY(GPU_EXTENSION);          // path xml configuration file
 __DECLARE_CONFIG_KEY(VPU_EXTENSION);          // path xml configuration file
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+#include <atomic>
+#include <string>
+
+extern "C" {
+#endif /* __cplusplus */
+
+/* Event phases match Chrome trace_event format letters */
+typedef enum {
+    LATENCY_TRACER_SCOPE = 'X',         /* duration event on the recording thread */
+    LATENCY_TRACER_INSTANT = 'i',       /* point-in-time event on the recording thread */
+    LATENCY_TRACER_ELEMENT_ENTER = 'b', /* buffer with given id entered element */
+    LATENCY_TRACER_ELEMENT_EXIT = 'e'   /* buffer with given id left element */
+} LatencyTracerPhase;
+
+/* Recording is off until enabled, so instrumented code costs one atomic load per marker */
+void latency_tracer_enable(int enable);
+int latency_tracer_is_enabled(void);
+
+/* Monotonic timestamp in nanoseconds */
+uint64_t latency_tracer_now(void);
+
+/* Returns a copy of name which stays valid until process exit. Recorded names must have such lifetime */
+const char *latency_tracer_intern(const char *name);
+
+/* Lock-free append to the calling thread's ring buffer. Oldest events are overwritten when the ring is full */
+void latency_tracer_record(const char *name, LatencyTracerPhase phase, uint64_t id, uint64_t timestamp,
+                           uint64_t duration);
+
+/* Writes Chrome trace_event JSON (summary == 0) or per-element/per-stage latency table (summary != 0).
+ * Returns 0 on success */
+int latency_tracer_dump(const char *path, int summary);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+namespace LatencyTracer {
+
+// Defined in shared gvalatencyrecorder library, so all plugins see one flag
+extern std::atomic<bool> enabled_flag;
+
+inline bool enabled() {
+    return enabled_flag.load(std::memory_order_relaxed);
+}
+
+// Name must stay valid until process exit, as for Scope
+inline void instant(const char *name, uint64_t id = 0) {
+    if (enabled())
+        latency_tracer_record(name, LATENCY_TRACER_INSTANT, id, latency_tracer_now(), 0);
+}
+
+// Records duration event covering lifetime of the object
+class Scope {
+  public:
+    // Name is recorded as is and must stay valid until process exit (string literal or latency_tracer_intern result)
+    Scope(const char *name, uint64_t id = 0) : name(enabled() ? name : nullptr), id(id), begin(0) {
+        if (this->name)
+            begin = latency_tracer_now();
+    }
+    // Name of any lifetime, it is interned
+    Scope(const std::string &name, uint64_t id = 0)
+        : name(enabled() ? latency_tracer_intern(name.c_str()) : nullptr), id(id), begin(0) {
+        if (this->name)
+            begin = latency_tracer_now();
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() {
+        if (name)
+            latency_tracer_record(name, LATENCY_TRACER_SCOPE, id, begin, latency_tracer_now() - begin);
+    }
+
+  private:
+    const char *name;
+    uint64_t id;
+    uint64_t begin;
+};
+
+} // namespace LatencyTracer
+
+#define LATENCY_TRACE_SCOPE(NAME, ID) LatencyTracer::Scope latency_scope(NAME, ID)
+#define LATENCY_TRACE_INSTANT(NAME, ID) LatencyTracer::instant(NAME, ID)
+
+#endif /* __cplusplus */
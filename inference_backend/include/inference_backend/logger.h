@@ -36,25 +36,41 @@ void debug_log(int level, const char *file, const char *function, int line, cons
 
 void default_log_function(int level, const char *file, const char *function, int line, const char *message);
 
-#if defined(ENABLE_ITT) && defined(__cplusplus)
-#include "ittnotify.h"
+#ifdef __cplusplus
+#include "latency_tracer.h"
 #include <string>
 
+#ifdef ENABLE_ITT
+#include "ittnotify.h"
+#endif
+
+// Marks scope for Intel ITT (if enabled at build time) and for built-in latency tracer (if enabled at runtime)
+// NAME is a string literal or std::string, temporary C strings (e.g. std::string::c_str()) must not be passed
 #define ITT_TASK(NAME) ITTTask task(NAME)
 
 class ITTTask {
   public:
-    ITTTask(const char *name);
-    ITTTask(const std::string &name);
-    ~ITTTask();
+    ITTTask(const char *name) : latency_scope(name) {
+        taskBegin(name);
+    }
+    ITTTask(const std::string &name) : latency_scope(name) {
+        taskBegin(name.c_str());
+    }
+    ~ITTTask() {
+        taskEnd();
+    }
 
   private:
+#ifdef ENABLE_ITT
     void taskBegin(const char *name);
     void taskEnd();
-};
-
 #else
-
-#define ITT_TASK(NAME)
+    void taskBegin(const char *) {
+    }
+    void taskEnd() {
+    }
+#endif
+    LatencyTracer::Scope latency_scope;
+};
 
 #endif
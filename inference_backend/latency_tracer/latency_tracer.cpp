@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#include "inference_backend/latency_tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+std::atomic<bool> LatencyTracer::enabled_flag(false);
+
+namespace {
+
+constexpr uint64_t RING_CAPACITY = 1 << 15; // must be power of 2
+
+struct Event {
+    const char *name;
+    uint64_t id;
+    uint64_t timestamp;
+    uint64_t duration;
+    char phase;
+    uint32_t tid;
+};
+
+// Single producer (owning thread), any number of readers taking snapshots
+class ThreadRing {
+  public:
+    explicit ThreadRing(uint32_t tid) : tid(tid), events(RING_CAPACITY), head(0) {
+    }
+
+    void push(const char *name, char phase, uint64_t id, uint64_t timestamp, uint64_t duration) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        Event &event = events[h & (RING_CAPACITY - 1)];
+        event.name = name;
+        event.id = id;
+        event.timestamp = timestamp;
+        event.duration = duration;
+        event.phase = phase;
+        event.tid = tid;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    void snapshot(std::vector<Event> &out) const {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        const uint64_t begin = end > RING_CAPACITY ? end - RING_CAPACITY : 0;
+        std::vector<Event> copy;
+        copy.reserve(end - begin);
+        for (uint64_t i = begin; i < end; i++)
+            copy.push_back(events[i & (RING_CAPACITY - 1)]);
+        // drop events which owner thread could overwrite while we were copying
+        const uint64_t new_end = head.load(std::memory_order_acquire);
+        const uint64_t valid_begin = new_end > RING_CAPACITY ? new_end - RING_CAPACITY : 0;
+        for (uint64_t i = std::max(begin, valid_begin); i < end; i++)
+            out.push_back(copy[i - begin]);
+    }
+
+  private:
+    const uint32_t tid;
+    std::vector<Event> events;
+    std::atomic<uint64_t> head;
+};
+
+std::mutex registry_mutex;
+
+std::vector<std::shared_ptr<ThreadRing>> &registry() {
+    static std::vector<std::shared_ptr<ThreadRing>> rings;
+    return rings;
+}
+
+ThreadRing &local_ring() {
+    // registry keeps ring alive after thread exit so its events are still dumped
+    thread_local std::shared_ptr<ThreadRing> ring;
+    if (!ring) {
+        std::lock_guard<std::mutex> guard(registry_mutex);
+        ring = std::make_shared<ThreadRing>(static_cast<uint32_t>(registry().size() + 1));
+        registry().push_back(ring);
+    }
+    return *ring;
+}
+
+std::vector<Event> collect_events() {
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> guard(registry_mutex);
+        for (const auto &ring : registry())
+            ring->snapshot(events);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &l, const Event &r) { return l.timestamp < r.timestamp; });
+    return events;
+}
+
+// Element names and gvapython module/function names may contain any characters
+std::string escape_json(const char *str) {
+    std::string escaped;
+    for (const char *c = str; *c; c++) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        switch (ch) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (ch < 0x20) {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", ch);
+                escaped += code;
+            } else {
+                escaped += static_cast<char>(ch);
+            }
+        }
+    }
+    return escaped;
+}
+
+void write_chrome_trace(FILE *file, const std::vector<Event> &events) {
+    const int pid = getpid();
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (const Event &event : events) {
+        const std::string name = escape_json(event.name);
+        const double ts = event.timestamp / 1000.0;
+        fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u", first ? "" : ",",
+                name.c_str(), event.phase, ts, pid, event.tid);
+        switch (event.phase) {
+        case LATENCY_TRACER_SCOPE:
+            fprintf(file, ",\"cat\":\"stage\",\"dur\":%.3f,\"args\":{\"id\":%llu}}", event.duration / 1000.0,
+                    static_cast<unsigned long long>(event.id));
+            break;
+        case LATENCY_TRACER_INSTANT:
+            fprintf(file, ",\"cat\":\"stage\",\"s\":\"t\",\"args\":{\"id\":%llu}}",
+                    static_cast<unsigned long long>(event.id));
+            break;
+        default:
+            // async events are matched by category, name and id
+            fprintf(file, ",\"cat\":\"element\",\"id\":\"0x%llx\"}", static_cast<unsigned long long>(event.id));
+            break;
+        }
+        first = false;
+    }
+    fprintf(file, "\n]}\n");
+}
+
+struct Stats {
+    std::vector<double> samples_ms;
+    uint64_t count = 0;
+
+    void add(uint64_t duration_ns) {
+        samples_ms.push_back(duration_ns / 1e6);
+    }
+};
+
+void print_stats(FILE *file, const char *kind, const std::string &name, Stats &stats) {
+    if (stats.samples_ms.empty()) {
+        fprintf(file, "%-8s %-40s %10llu\n", kind, name.c_str(), static_cast<unsigned long long>(stats.count));
+        return;
+    }
+    std::vector<double> &s = stats.samples_ms;
+    std::sort(s.begin(), s.end());
+    double sum = 0;
+    for (double v : s)
+        sum += v;
+    const double p95 = s[std::min(s.size() - 1, static_cast<size_t>(s.size() * 0.95))];
+    fprintf(file, "%-8s %-40s %10zu %10.3f %10.3f %10.3f %10.3f\n", kind, name.c_str(), s.size(), sum / s.size(),
+            s.front(), p95, s.back());
+}
+
+void write_summary(FILE *file, const std::vector<Event> &events) {
+    std::map<std::pair<const char *, uint64_t>, uint64_t> entered;
+    std::map<std::string, Stats> elements;
+    std::map<std::string, Stats> stages;
+    std::map<std::string, Stats> instants;
+
+    for (const Event &event : events) {
+        switch (event.phase) {
+        case LATENCY_TRACER_ELEMENT_ENTER:
+            // keep earliest entry if buffer re-enters element (e.g. loops via tee)
+            entered.emplace(std::make_pair(event.name, event.id), event.timestamp);
+            break;
+        case LATENCY_TRACER_ELEMENT_EXIT: {
+            auto it = entered.find(std::make_pair(event.name, event.id));
+            if (it != entered.end()) {
+                elements[event.name].add(event.timestamp - it->second);
+                entered.erase(it);
+            }
+            break;
+        }
+        case LATENCY_TRACER_SCOPE:
+            stages[event.name].add(event.duration);
+            break;
+        case LATENCY_TRACER_INSTANT:
+            instants[event.name].count++;
+            break;
+        }
+    }
+
+    fprintf(file, "%-8s %-40s %10s %10s %10s %10s %10s\n", "# kind", "name", "count", "avg,ms", "min,ms", "p95,ms",
+            "max,ms");
+    for (auto &element : elements)
+        print_stats(file, "element", element.first, element.second);
+    for (auto &stage : stages)
+        print_stats(file, "stage", stage.first, stage.second);
+    for (auto &instant : instants)
+        print_stats(file, "instant", instant.first, instant.second);
+}
+
+} // namespace
+
+void latency_tracer_enable(int enable) {
+    LatencyTracer::enabled_flag.store(enable != 0, std::memory_order_relaxed);
+}
+
+int latency_tracer_is_enabled(void) {
+    return LatencyTracer::enabled();
+}
+
+uint64_t latency_tracer_now(void) {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+const char *latency_tracer_intern(const char *name) {
+    static std::mutex intern_mutex;
+    static std::unordered_set<std::string> interned;
+    std::lock_guard<std::mutex> guard(intern_mutex);
+    return interned.emplace(name ? name : "").first->c_str();
+}
+
+void latency_tracer_record(const char *name, LatencyTracerPhase phase, uint64_t id, uint64_t timestamp,
+                           uint64_t duration) {
+    if (!LatencyTracer::enabled() || !name)
+        return;
+    local_ring().push(name, static_cast<char>(phase), id, timestamp, duration);
+}
+
+int latency_tracer_dump(const char *path, int summary) {
+    if (!path)
+        return -1;
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return -1;
+    const std::vector<Event> events = collect_events();
+    if (summary)
+        write_summary(file, events);
+    else
+        write_chrome_trace(file, events);
+    return fclose(file) == 0 ? 0 : -1;
+}
@@ -10,18 +10,6 @@
 
 static __itt_domain *itt_domain = nullptr;
 
-ITTTask::ITTTask(const char *name) {
-    taskBegin(name);
-}
-
-ITTTask::ITTTask(const std::string &name) {
-    taskBegin(name.c_str());
-}
-
-ITTTask::~ITTTask() {
-    taskEnd();
-}
-
 void ITTTask::taskBegin(const char *name) {
     if (itt_domain == nullptr) {
         itt_domain = __itt_domain_create("video-analytics");
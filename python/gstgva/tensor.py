@@ -17,9 +17,28 @@ gi.require_version('Gst', '1.0')
 
 from enum import Enum
 from gi.repository import GObject, Gst
-from .util import libgst, libgobject, G_VALUE_ARRAY_POINTER, GValueArray, GValue, G_VALUE_POINTER
+from .util import libgst, libgobject, libglib, G_VALUE_ARRAY_POINTER, GValueArray, GValue, G_VALUE_POINTER
 from .util import GVATensorMeta
 
+
+## @brief This class holds reference to GVariant owning tensor bytes and exposes them to numpy through array interface
+# without copying. numpy keeps instance of this class as base of created array, so tensor bytes stay valid as long as
+# array (or any view of it) is alive, even if Tensor is modified or buffer with Tensor is freed
+class _TensorData:
+    def __init__(self, variant: ctypes.c_void_p, data_ptr: ctypes.c_void_p, nbytes: int):
+        self.__variant = libglib.g_variant_ref(variant)
+        self.__array_interface__ = {
+            'version': 3,
+            'shape': (nbytes, ),
+            'typestr': '|u1',
+            # (pointer, read-only flag): array stays writable as before, changes go to tensor bytes in place
+            'data': (data_ptr, False)
+        }
+
+    def __del__(self):
+        libglib.g_variant_unref(self.__variant)
+
+
 ## @brief This class represents tensor - map-like storage for inference result information, such as output blob
 # description (output layer dims, layout, rank, precision, etc.), inference result in a raw and interpreted forms.
 # Tensor is based on GstStructure and, in general, can contain arbitrary (user-defined) fields of simplest data types,
@@ -67,7 +86,7 @@ class Tensor:
         except:
             return self.LAYOUT.ANY
 
-    ## @brief Get raw inference result blob data
+    ## @brief Get raw inference result blob data. Returned array is a writable view of tensor bytes, no data is copied
     #  @return numpy.ndarray of values representing raw inference data, None if data can't be read
     def data(self) -> numpy.ndarray:
         precision = self.precision()
@@ -81,11 +100,14 @@ class Tensor:
             self.__structure, 'data_buffer'.encode('utf-8'))
         if gvalue:
             gvariant = libgobject.g_value_get_variant(gvalue)
+            if not gvariant:
+                return None
             nbytes = ctypes.c_size_t()
             data_ptr = libgobject.g_variant_get_fixed_array(
                 gvariant, ctypes.byref(nbytes), 1)
-            array_type = ctypes.c_ubyte * nbytes.value
-            return numpy.ctypeslib.as_array(array_type.from_address(data_ptr)).view(dtype=view)
+            if not data_ptr or not nbytes.value:
+                return numpy.empty(0, dtype=view)
+            return numpy.asarray(_TensorData(gvariant, data_ptr, nbytes.value)).view(dtype=view)
         return None
 
     ## @brief Get name as a string
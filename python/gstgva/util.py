@@ -230,6 +230,10 @@ libgobject.g_value_get_uint.restype = ctypes.c_uint
 libglib = ctypes.CDLL('libglib-2.0.so')
 libglib.g_strdup.argtypes = [ctypes.c_char_p]
 libglib.g_strdup.restype = ctypes.c_void_p
+libglib.g_variant_ref.argtypes = [ctypes.c_void_p]
+libglib.g_variant_ref.restype = ctypes.c_void_p
+libglib.g_variant_unref.argtypes = [ctypes.c_void_p]
+libglib.g_variant_unref.restype = None
 
 # libgstvideo
 libgstvideo = ctypes.CDLL("libgstvideo-1.0.so")
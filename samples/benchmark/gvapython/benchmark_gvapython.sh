@@ -0,0 +1,34 @@
+#!/bin/bash
+# ==============================================================================
+# Copyright (C) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: MIT
+# ==============================================================================
+
+set -e
+
+BATCH_SIZE=${1:-1}
+CHANNELS_COUNT=${2:-8}
+NUM_BUFFERS=${3:-3000}
+
+SCRIPTDIR="$(dirname "$(realpath "$0")")"
+
+if [ $BATCH_SIZE -gt 1 ]; then
+  GVAPYTHON="gvapython module=$SCRIPTDIR/callback.py function=process_frames batch-size=$BATCH_SIZE"
+else
+  GVAPYTHON="gvapython module=$SCRIPTDIR/callback.py function=process_frame"
+fi
+
+PIPELINE=" videotestsrc num-buffers=${NUM_BUFFERS} pattern=black ! video/x-raw,format=BGRx,width=640,height=360 ! \
+${GVAPYTHON} ! gvafpscounter ! fakesink sync=false "
+
+FINAL_PIPELINE_STR=""
+
+for (( CURRENT_CHANNELS_COUNT=0; CURRENT_CHANNELS_COUNT < $CHANNELS_COUNT; ++CURRENT_CHANNELS_COUNT ))
+do
+  FINAL_PIPELINE_STR+=$PIPELINE
+done
+
+echo "gst-launch-1.0 ${FINAL_PIPELINE_STR}"
+PYTHONPATH=$PYTHONPATH:$SCRIPTDIR/../../../python \
+gst-launch-1.0 ${FINAL_PIPELINE_STR}
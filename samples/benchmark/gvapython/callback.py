@@ -0,0 +1,20 @@
+# ==============================================================================
+# Copyright (C) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: MIT
+# ==============================================================================
+
+from typing import List
+
+from gstgva import VideoFrame
+
+
+def process_frame(frame: VideoFrame) -> bool:
+    frame.regions()
+    return True
+
+
+def process_frames(frames: List[VideoFrame]) -> bool:
+    for frame in frames:
+        frame.regions()
+    return True
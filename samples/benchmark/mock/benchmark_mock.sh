@@ -0,0 +1,34 @@
+#!/bin/bash
+# ==============================================================================
+# Copyright (C) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: MIT
+# ==============================================================================
+
+set -e
+
+DETECT_MODEL=${1:-ssd}
+CHANNELS_COUNT=${2:-1}
+NUM_BUFFERS=${3:-3000}
+BATCH_SIZE=${4:-1}
+
+SCRIPTDIR="$(dirname "$(realpath "$0")")"
+
+if [ $DETECT_MODEL == yolo-v2-tiny ]; then
+  MODEL_PROC="model-proc=$SCRIPTDIR/../../model_proc/yolo-v2-tiny-tf.json"
+fi
+
+PIPELINE=" videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,format=BGRx,width=1280,height=720 ! \
+gvadetect model=$SCRIPTDIR/${DETECT_MODEL}.json ${MODEL_PROC} device=MOCK pre-process-backend=opencv batch-size=${BATCH_SIZE} ! queue ! \
+gvaclassify model=$SCRIPTDIR/classification.json device=MOCK pre-process-backend=opencv ! queue ! \
+gvafpscounter ! fakesink sync=false "
+
+FINAL_PIPELINE_STR=""
+
+for (( CURRENT_CHANNELS_COUNT=0; CURRENT_CHANNELS_COUNT < $CHANNELS_COUNT; ++CURRENT_CHANNELS_COUNT ))
+do
+  FINAL_PIPELINE_STR+=$PIPELINE
+done
+
+echo "gst-launch-1.0 ${FINAL_PIPELINE_STR}"
+gst-launch-1.0 ${FINAL_PIPELINE_STR}
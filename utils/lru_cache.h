@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: MIT
  ******************************************************************************/
 
+#pragma once
+
 #include <list>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 template <typename Key_T, typename Value_T>
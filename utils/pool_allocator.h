@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (C) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Utils {
+
+// Process-wide counters of all pools, used to check that steady state does not hit the heap
+struct PoolStats {
+    std::atomic<size_t> heap_allocations{0};
+    std::atomic<size_t> reused{0};
+};
+
+inline PoolStats &GetPoolStats() {
+    static PoolStats stats;
+    return stats;
+}
+
+// Thread-safe cache of equally sized memory blocks. Blocks released by one thread are reused by another, which fits
+// objects created on streaming thread and destroyed on inference/post-processing threads
+class BlockPool {
+  public:
+    BlockPool(size_t block_size, size_t max_cached_blocks)
+        : block_size(block_size), max_cached_blocks(max_cached_blocks) {
+    }
+
+    void *Pop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!blocks.empty()) {
+                void *block = blocks.back();
+                blocks.pop_back();
+                GetPoolStats().reused.fetch_add(1, std::memory_order_relaxed);
+                return block;
+            }
+        }
+        GetPoolStats().heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(block_size);
+    }
+
+    void Push(void *block) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (blocks.size() < max_cached_blocks) {
+                blocks.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+  private:
+    const size_t block_size;
+    const size_t max_cached_blocks;
+    std::vector<void *> blocks;
+    std::mutex mutex;
+};
+
+// Allocator for std::allocate_shared: object and its reference counter share one pooled block, so creating
+// and releasing short-lived shared objects does not go to the heap in steady state
+template <typename T>
+class PoolAllocator {
+  public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {
+    }
+
+    T *allocate(size_t n) {
+        if (n != 1)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(Pool().Pop());
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (n != 1)
+            ::operator delete(p);
+        else
+            Pool().Push(p);
+    }
+
+    // One pool per type, never destroyed so that objects released during static destruction are still valid
+    static BlockPool &Pool() {
+        static BlockPool *pool = new BlockPool(sizeof(T), 4096);
+        return *pool;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const {
+        return false;
+    }
+};
+
+} // namespace Utils